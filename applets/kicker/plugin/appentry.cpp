@@ -7,12 +7,12 @@
 #include "appentry.h"
 #include "actionlist.h"
 #include "appsmodel.h"
+#include "appssnapshot.h"
 #include "containmentinterface.h"
 #include <config-workspace.h>
 
 #include <config-X11.h>
 
-#include <QFileInfo>
 #include <QProcess>
 #include <QQmlPropertyMap>
 #include <QStandardPaths>
@@ -35,100 +35,10 @@
 #include <KSharedConfig>
 #include <KShell>
 #include <KStartupInfo>
-#include <KSycoca>
 #include <KWindowSystem>
 
 #include <Plasma/Plasma>
 
-#ifdef HAVE_ICU
-#include <unicode/translit.h>
-#endif
-
-namespace
-{
-
-#ifdef HAVE_ICU
-std::unique_ptr<icu::Transliterator> getICUTransliterator(const QLocale &locale)
-{
-    // Only use transliterator for certain locales.
-    // Because application name is a localized string, it would be really rare to
-    // have Chinese/Japanese character on other locales. Even if that happens, it
-    // is ok to use to the old 1 character strategy instead of using transliterator.
-    icu::UnicodeString id;
-    if (locale.language() == QLocale::Japanese) {
-        id = "Katakana-Hiragana";
-    } else if (locale.language() == QLocale::Chinese) {
-        id = "Han-Latin; Latin-ASCII";
-    }
-    if (id.isEmpty()) {
-        return nullptr;
-    }
-    auto ue = UErrorCode::U_ZERO_ERROR;
-    auto transliterator = std::unique_ptr<icu::Transliterator>(icu::Transliterator::createInstance(id, UTRANS_FORWARD, ue));
-
-    if (ue != UErrorCode::U_ZERO_ERROR) {
-        return nullptr;
-    }
-
-    return transliterator;
-}
-#endif
-
-QString groupName(const QString &name)
-{
-    if (name.isEmpty()) {
-        return QString();
-    }
-
-    const QChar firstChar = name[0];
-
-    // Put all applications whose names begin with numbers in group #
-    if (firstChar.isDigit()) {
-        return QStringLiteral("#");
-    }
-
-    // Put all applications whose names begin with punctuations/symbols/spaces in group &
-    if (firstChar.isPunct() || firstChar.isSymbol() || firstChar.isSpace()) {
-        return QStringLiteral("&");
-    }
-
-    // Here we will apply a locale based strategy for the first character.
-    // If first character is hangul, run decomposition and return the choseong (consonants).
-    if (firstChar.script() == QChar::Script_Hangul) {
-        auto decomposed = firstChar.decomposition();
-        if (decomposed.isEmpty()) {
-            return name.left(1);
-        }
-        return decomposed.left(1);
-    }
-    const auto locale = QLocale::system();
-    if (locale.language() == QLocale::Japanese) {
-        // We do this here for Japanese locale because:
-        // 1. it does not make much sense to have every different Kanji to have a different group.
-        // 2. ICU transliterator can't yet convert Kanji to Hiragana.
-        //    https://unicode-org.atlassian.net/browse/ICU-5874
-        if (firstChar.script() == QChar::Script_Han) {
-            // Unicode Han
-            return QString::fromUtf8("\xe6\xbc\xa2");
-        }
-    }
-#ifdef HAVE_ICU
-    // Precondition to use transliterator.
-    if ((locale.language() == QLocale::Chinese && firstChar.script() == QChar::Script_Han)
-        || (locale.language() == QLocale::Japanese && firstChar.script() == QChar::Script_Katakana)) {
-        static auto transliterator = getICUTransliterator(locale);
-
-        if (transliterator) {
-            icu::UnicodeString icuText(reinterpret_cast<const char16_t *>(name.data()), name.size());
-            transliterator->transliterate(icuText);
-            return QString::fromUtf16(icuText.getBuffer(), static_cast<int>(icuText.length())).left(1);
-        }
-    }
-#endif
-    return name.left(1);
-}
-}
-
 AppEntry::AppEntry(AbstractModel *owner, KService::Ptr service, NameFormat nameFormat)
     : AbstractEntry(owner)
     , m_service(service)
@@ -146,7 +56,7 @@ AppEntry::AppEntry(AbstractModel *owner, const QString &id)
     if (url.scheme() == QLatin1String("preferred")) {
         m_service = defaultAppByName(url.host());
         m_id = id;
-        m_con = QObject::connect(KSycoca::self(), &KSycoca::databaseChanged, owner, [this, owner, id]() {
+        m_con = QObject::connect(AppsSnapshotWatcher::self(), &AppsSnapshotWatcher::changed, owner, [this, owner, id]() {
             KSharedConfig::openConfig()->reparseConfiguration();
             m_service = defaultAppByName(QUrl(id).host());
             if (m_service) {
@@ -166,13 +76,27 @@ AppEntry::AppEntry(AbstractModel *owner, const QString &id)
 
 void AppEntry::init(NameFormat nameFormat)
 {
-    m_name = nameFromService(m_service, nameFormat);
+    const AppsSnapshot::Application application = AppsSnapshot::current()->application(m_service, nameFormat);
 
-    if (nameFormat == GenericNameOnly) {
-        m_description = nameFromService(m_service, NameOnly);
-    } else {
-        m_description = nameFromService(m_service, GenericNameOnly);
+    m_name = application.name;
+    m_description = application.description;
+    m_group = application.group;
+}
+
+bool AppEntry::updateService(const KService::Ptr &service, NameFormat nameFormat)
+{
+    const QString oldName = m_name;
+    const QString oldDescription = m_description;
+    const QString oldIcon = m_service ? m_service->icon() : QString();
+
+    m_service = service;
+    init(nameFormat);
+
+    if (m_service->icon() != oldIcon) {
+        m_icon = QIcon();
     }
+
+    return m_name != oldName || m_description != oldDescription || m_service->icon() != oldIcon;
 }
 
 bool AppEntry::isValid() const
@@ -183,11 +107,7 @@ bool AppEntry::isValid() const
 QIcon AppEntry::icon() const
 {
     if (m_icon.isNull()) {
-        if (QFileInfo::exists(m_service->icon())) {
-            m_icon = QIcon(m_service->icon());
-        } else {
-            m_icon = QIcon::fromTheme(m_service->icon(), QIcon::fromTheme(QStringLiteral("unknown")));
-        }
+        m_icon = AppsSnapshot::current()->icon(m_service->icon());
     }
     return m_icon;
 }
@@ -209,13 +129,6 @@ KService::Ptr AppEntry::service() const
 
 QString AppEntry::group() const
 {
-    if (m_group.isNull()) {
-        m_group = groupName(m_name);
-        if (m_group.isNull()) {
-            m_group = QLatin1String("");
-        }
-        Q_ASSERT(!m_group.isNull());
-    }
     return m_group;
 }
 
@@ -428,7 +341,7 @@ AppGroupEntry::AppGroupEntry(AppsModel *parentModel,
 QIcon AppGroupEntry::icon() const
 {
     if (m_icon.isNull()) {
-        m_icon = QIcon::fromTheme(m_group->icon(), QIcon::fromTheme(QStringLiteral("unknown")));
+        m_icon = AppsSnapshot::current()->icon(m_group->icon());
     }
     return m_icon;
 }
@@ -447,3 +360,25 @@ AbstractModel *AppGroupEntry::childModel() const
 {
     return m_childModel;
 }
+
+QString AppGroupEntry::entryPath() const
+{
+    return m_group->entryPath();
+}
+
+bool AppGroupEntry::updateGroup(const KServiceGroup::Ptr &group)
+{
+    const bool iconChanged = group->icon() != m_group->icon();
+    const bool changed = iconChanged || group->caption() != m_group->caption();
+
+    if (iconChanged) {
+        m_icon = QIcon();
+    }
+    m_group = group;
+
+    if (AppsModel *model = qobject_cast<AppsModel *>(m_childModel.data())) {
+        model->updateEntries();
+    }
+
+    return changed;
+}
@@ -53,6 +53,12 @@ public:
 
     QString menuId() const;
 
+    /**
+     * Switches to @p service, the same application out of a rebuilt sycoca database
+     * @return whether anything shown for the entry changed
+     */
+    bool updateService(const KService::Ptr &service, NameFormat nameFormat);
+
     static QString nameFromService(const KService::Ptr &service, NameFormat nameFormat);
     static KService::Ptr defaultAppByName(const QString &name);
 
@@ -63,7 +69,7 @@ private:
     QString m_name;
     QString m_description;
     // Not an actual group name, but the first character for transliterated name.
-    mutable QString m_group;
+    QString m_group;
     mutable QIcon m_icon;
     KService::Ptr m_service;
     static MenuEntryEditor *m_menuEntryEditor;
@@ -81,6 +87,14 @@ public:
     bool hasChildren() const override;
     AbstractModel *childModel() const override;
 
+    QString entryPath() const;
+
+    /**
+     * Switches to @p group, the same menu out of a rebuilt sycoca database, and updates the submenu
+     * @return whether anything shown for the entry changed
+     */
+    bool updateGroup(const KServiceGroup::Ptr &group);
+
 private:
     KServiceGroup::Ptr m_group;
     mutable QIcon m_icon;
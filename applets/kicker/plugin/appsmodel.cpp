@@ -7,19 +7,43 @@
 
 #include "appsmodel.h"
 #include "actionlist.h"
+#include "appssnapshot.h"
 #include "rootmodel.h"
 
-#include <QCollator>
+#include <QCollatorSortKey>
 #include <QDebug>
 #include <QQmlPropertyMap>
 #include <QTimer>
 
 #include <KLocalizedString>
-#include <KSycoca>
 #include <chrono>
+#include <vector>
 
 using namespace std::chrono_literals;
 
+// Drops the applications which are in the list already, like the same .desktop file in several menus
+static QList<AbstractEntry *> uniqueEntries(const QList<AbstractEntry *> &entryList)
+{
+    QList<AbstractEntry *> entries;
+    entries.reserve(entryList.count());
+    QSet<QString> storageIds;
+
+    for (AbstractEntry *entry : entryList) {
+        if (entry->type() == AbstractEntry::RunnableType) {
+            const KService::Ptr service = static_cast<const AppEntry *>(entry)->service();
+            if (service) {
+                if (storageIds.contains(service->storageId())) {
+                    continue;
+                }
+                storageIds.insert(service->storageId());
+            }
+        }
+        entries << entry;
+    }
+
+    return entries;
+}
+
 AppsModel::AppsModel(const QString &entryPath, bool paginate, int pageSize, bool flat, bool sorted, bool separators, QObject *parent)
     : AbstractModel(parent)
     , m_complete(false)
@@ -39,7 +63,15 @@ AppsModel::AppsModel(const QString &entryPath, bool paginate, int pageSize, bool
     , m_sorted(sorted)
     , m_appNameFormat(AppEntry::NameOnly)
 {
-    if (!m_entryPath.isEmpty()) {
+    if (m_entryPath.isEmpty()) {
+        // Only the top level watches the database, it updates the submenus
+        m_changeTimer = new QTimer(this);
+        m_changeTimer->setSingleShot(true);
+        m_changeTimer->setInterval(100ms);
+        connect(m_changeTimer, &QTimer::timeout, this, &AppsModel::refreshFromSycoca);
+
+        connect(AppsSnapshotWatcher::self(), &AppsSnapshotWatcher::changed, m_changeTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    } else {
         componentComplete();
     }
 }
@@ -63,18 +95,7 @@ AppsModel::AppsModel(const QList<AbstractEntry *> &entryList, bool deleteEntries
     , m_sorted(true)
     , m_appNameFormat(AppEntry::NameOnly)
 {
-    for (AbstractEntry *suggestedEntry : entryList) {
-        const auto sameStorageId = [=](const AbstractEntry *entry) {
-            return entry->type() == AbstractEntry::RunnableType
-                && static_cast<const AppEntry *>(entry)->service()->storageId() == static_cast<const AppEntry *>(suggestedEntry)->service()->storageId();
-        };
-
-        const bool found = std::find_if(m_entryList.cbegin(), m_entryList.cend(), sameStorageId) != m_entryList.cend();
-
-        if (!found) {
-            m_entryList << suggestedEntry;
-        }
-    }
+    m_entryList = uniqueEntries(entryList);
 
     sortEntries(m_entryList);
     refreshSectionList();
@@ -477,10 +498,131 @@ void AppsModel::refresh()
     Q_EMIT separatorCountChanged();
 }
 
-static bool containsSameStorageId(const QList<AbstractEntry *> &entryList, const KService::Ptr &service)
+void AppsModel::refreshFromSycoca()
+{
+    if (rootModel() == this && !m_appletInterface) {
+        return;
+    }
+
+    updateEntries();
+
+    if (favoritesModel()) {
+        favoritesModel()->refresh();
+    }
+}
+
+void AppsModel::updateEntries()
+{
+    if (!m_complete || m_staticEntryList) {
+        return;
+    }
+
+    // Pages are cut out of the sorted list, one application more or less shifts all of them
+    if (m_paginate && !m_entryPath.isEmpty()) {
+        refresh();
+        return;
+    }
+
+    const int oldCount = m_entryList.count();
+    const int oldSeparatorCount = m_separatorCount;
+
+    const QList<AbstractEntry *> entries = buildEntryList(m_entryList);
+    applyEntryList(entries, 0, m_entryList.count(), true);
+    refreshSectionList();
+
+    if (m_entryList.count() != oldCount) {
+        Q_EMIT countChanged();
+    }
+    if (m_separatorCount != oldSeparatorCount) {
+        Q_EMIT separatorCountChanged();
+    }
+}
+
+void AppsModel::setEntries(const QList<AbstractEntry *> &entryList)
 {
-    return std::any_of(entryList.cbegin(), entryList.cend(), [=](const AbstractEntry *entry) {
-        return entry->type() == AbstractEntry::RunnableType && static_cast<const AppEntry *>(entry)->service()->storageId() == service->storageId();
+    Q_ASSERT(m_staticEntryList);
+
+    const int oldCount = m_entryList.count();
+
+    QList<AbstractEntry *> entries = uniqueEntries(entryList);
+    sortEntries(entries);
+    applyEntryList(entries, 0, m_entryList.count(), m_deleteEntriesOnDestruction);
+
+    // The entries are shared with other models, which updated them
+    if (!m_entryList.isEmpty()) {
+        Q_EMIT dataChanged(index(0, 0), index(m_entryList.count() - 1, 0));
+    }
+
+    refreshSectionList();
+
+    if (m_entryList.count() != oldCount) {
+        Q_EMIT countChanged();
+    }
+}
+
+void AppsModel::applyEntryList(const QList<AbstractEntry *> &entryList, int first, int count, bool ownsEntries)
+{
+    const QSet<AbstractEntry *> kept(entryList.cbegin(), entryList.cend());
+    QList<AbstractEntry *> removed;
+
+    // From the back so the rows in front stay valid
+    for (int row = first + count - 1; row >= first; --row) {
+        AbstractEntry *entry = m_entryList.at(row);
+        if (kept.contains(entry)) {
+            continue;
+        }
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_entryList.removeAt(row);
+        endRemoveRows();
+
+        removed << entry;
+        --count;
+    }
+
+    // What is left of the old rows is in entryList too, in front of it everything is in place
+    for (int i = 0; i < entryList.count(); ++i) {
+        AbstractEntry *entry = entryList.at(i);
+        const int row = first + i;
+
+        if (i < count && m_entryList.at(row) == entry) {
+            continue;
+        }
+
+        const int from = m_entryList.indexOf(entry, row);
+
+        if (from != -1 && from < first + count) {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+            m_entryList.move(from, row);
+            endMoveRows();
+        } else {
+            beginInsertRows(QModelIndex(), row, row);
+            m_entryList.insert(row, entry);
+            endInsertRows();
+            ++count;
+        }
+    }
+
+    Q_ASSERT(count == entryList.count());
+
+    for (AbstractEntry *entry : std::as_const(m_changedEntries)) {
+        entryChanged(entry);
+    }
+    m_changedEntries.clear();
+
+    if (!ownsEntries) {
+        return;
+    }
+
+    for (AbstractEntry *entry : std::as_const(removed)) {
+        if (AbstractModel *childModel = entry->childModel()) {
+            childModel->deleteLater();
+        }
+    }
+
+    // Whoever got the rows removed signal may still be on its way out
+    QTimer::singleShot(0, [removed]() {
+        qDeleteAll(removed);
     });
 }
 
@@ -496,19 +638,38 @@ void AppsModel::refreshInternal()
         Q_EMIT cleared();
     }
 
+    m_entryList = buildEntryList(QList<AbstractEntry *>());
+
+    refreshSectionList();
+}
+
+QList<AbstractEntry *> AppsModel::buildEntryList(const QList<AbstractEntry *> &previousEntries)
+{
+    int separator = 0;
+
+    for (AbstractEntry *entry : previousEntries) {
+        if (entry->type() == AbstractEntry::RunnableType) {
+            const KService::Ptr service = static_cast<const AppEntry *>(entry)->service();
+            if (service) {
+                m_reusableEntries.insert(QLatin1String("app:") + service->storageId(), entry);
+            }
+        } else if (entry->type() == AbstractEntry::SeparatorType) {
+            m_reusableEntries.insert(QLatin1String("separator:") + QString::number(separator++), entry);
+        } else if (const AppGroupEntry *groupEntry = dynamic_cast<const AppGroupEntry *>(entry)) {
+            m_reusableEntries.insert(QLatin1String("group:") + groupEntry->entryPath(), entry);
+        }
+    }
+
     m_hiddenEntries.clear();
     m_separatorCount = 0;
+    m_storageIds.clear();
 
-    if (m_entryPath.isEmpty()) {
-        KServiceGroup::Ptr group = KServiceGroup::root();
-        if (!group) {
-            return;
-        }
+    QList<AbstractEntry *> entryList;
 
+    if (m_entryPath.isEmpty()) {
         bool sortByGenericName = (appNameFormat() == AppEntry::GenericNameOnly || appNameFormat() == AppEntry::GenericNameAndName);
 
-        KServiceGroup::List list =
-            group->entries(true /* sorted */, true /* excludeNoDisplay */, true /* allowSeparators */, sortByGenericName /* sortByGenericName */);
+        const KServiceGroup::List list = AppsSnapshot::current()->entries(QString(), true /* allowSeparators */, sortByGenericName /* sortByGenericName */);
 
         for (KServiceGroup::List::ConstIterator it = list.constBegin(); it != list.constEnd(); it++) {
             const KSycocaEntry::Ptr p = (*it);
@@ -517,8 +678,7 @@ void AppsModel::refreshInternal()
                 KServiceGroup::Ptr subGroup(static_cast<KServiceGroup *>(p.data()));
 
                 if (!subGroup->noDisplay() && subGroup->childCount() > 0) {
-                    AppGroupEntry *groupEntry = new AppGroupEntry(this, subGroup, m_paginate, m_pageSize, m_flat, m_sorted, m_showSeparators, m_appNameFormat);
-                    m_entryList << groupEntry;
+                    entryList << appGroupEntry(subGroup);
                 }
             } else if (p->isType(KST_KService) && m_showTopLevelItems) {
                 const KService::Ptr service(static_cast<KService *>(p.data()));
@@ -527,86 +687,101 @@ void AppsModel::refreshInternal()
                     continue;
                 }
 
-                if (!containsSameStorageId(m_entryList, service)) {
-                    m_entryList << new AppEntry(this, service, m_appNameFormat);
+                if (!m_storageIds.contains(service->storageId())) {
+                    entryList << appEntry(service);
                 }
             } else if (p->isType(KST_KServiceSeparator) && m_showSeparators && m_showTopLevelItems) {
-                if (!m_entryList.count()) {
+                if (!entryList.count()) {
                     continue;
                 }
 
-                if (m_entryList.last()->type() == AbstractEntry::SeparatorType) {
+                if (entryList.last()->type() == AbstractEntry::SeparatorType) {
                     continue;
                 }
 
-                m_entryList << new SeparatorEntry(this);
-                ++m_separatorCount;
+                entryList << separatorEntry();
             }
         }
+    } else {
+        processServiceGroup(m_entryPath, entryList);
+    }
 
-        if (m_entryList.count()) {
-            while (m_entryList.last()->type() == AbstractEntry::SeparatorType) {
-                m_entryList.removeLast();
-                --m_separatorCount;
-            }
+    while (!entryList.isEmpty() && entryList.last()->type() == AbstractEntry::SeparatorType) {
+        AbstractEntry *separator = entryList.takeLast();
+        --m_separatorCount;
+        if (!previousEntries.contains(separator)) {
+            delete separator;
         }
+    }
 
-        if (m_sorted) {
-            sortEntries(m_entryList);
-        }
+    m_reusableEntries.clear();
 
-        m_changeTimer = new QTimer(this);
-        m_changeTimer->setSingleShot(true);
-        m_changeTimer->setInterval(100ms);
-        connect(m_changeTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    if (m_sorted) {
+        sortEntries(entryList);
+    }
 
-        connect(KSycoca::self(), &KSycoca::databaseChanged, this, [this]() {
-            m_changeTimer->start();
-        });
-    } else {
-        KServiceGroup::Ptr group = KServiceGroup::group(m_entryPath);
-        processServiceGroup(group);
+    if (m_paginate && !m_entryPath.isEmpty()) {
+        QList<AbstractEntry *> groups;
+
+        int at = 0;
+        QList<AbstractEntry *> page;
+
+        for (AbstractEntry *app : std::as_const(entryList)) {
+            page.append(app);
 
-        if (m_entryList.count()) {
-            while (m_entryList.last()->type() == AbstractEntry::SeparatorType) {
-                m_entryList.removeLast();
-                --m_separatorCount;
+            if (at == (m_pageSize - 1)) {
+                at = 0;
+                AppsModel *model = new AppsModel(page, true, this);
+                groups.append(new GroupEntry(this, QString(), QString(), model));
+                page.clear();
+            } else {
+                ++at;
             }
         }
 
-        if (m_sorted) {
-            sortEntries(m_entryList);
+        if (page.count()) {
+            AppsModel *model = new AppsModel(page, true, this);
+            groups.append(new GroupEntry(this, QString(), QString(), model));
         }
 
-        if (m_paginate) {
-            QList<AbstractEntry *> groups;
+        entryList = groups;
+    }
 
-            int at = 0;
-            QList<AbstractEntry *> page;
+    return entryList;
+}
 
-            for (AbstractEntry *app : std::as_const(m_entryList)) {
-                page.append(app);
+AbstractEntry *AppsModel::appEntry(const KService::Ptr &service)
+{
+    m_storageIds.insert(service->storageId());
 
-                if (at == (m_pageSize - 1)) {
-                    at = 0;
-                    AppsModel *model = new AppsModel(page, true, this);
-                    groups.append(new GroupEntry(this, QString(), QString(), model));
-                    page.clear();
-                } else {
-                    ++at;
-                }
-            }
+    if (AbstractEntry *entry = m_reusableEntries.take(QLatin1String("app:") + service->storageId())) {
+        if (static_cast<AppEntry *>(entry)->updateService(service, m_appNameFormat)) {
+            m_changedEntries.insert(entry);
+        }
+        return entry;
+    }
 
-            if (page.count()) {
-                AppsModel *model = new AppsModel(page, true, this);
-                groups.append(new GroupEntry(this, QString(), QString(), model));
-            }
+    return new AppEntry(this, service, m_appNameFormat);
+}
 
-            m_entryList = groups;
+AbstractEntry *AppsModel::appGroupEntry(const KServiceGroup::Ptr &group)
+{
+    if (AbstractEntry *entry = m_reusableEntries.take(QLatin1String("group:") + group->entryPath())) {
+        if (static_cast<AppGroupEntry *>(entry)->updateGroup(group)) {
+            m_changedEntries.insert(entry);
         }
+        return entry;
     }
 
-    refreshSectionList();
+    return new AppGroupEntry(this, group, m_paginate, m_pageSize, m_flat, m_sorted, m_showSeparators, m_appNameFormat);
+}
+
+AbstractEntry *AppsModel::separatorEntry()
+{
+    AbstractEntry *entry = m_reusableEntries.take(QLatin1String("separator:") + QString::number(m_separatorCount));
+    ++m_separatorCount;
+
+    return entry ? entry : new SeparatorEntry(this);
 }
 
 void AppsModel::refreshSectionList()
@@ -639,31 +814,18 @@ void AppsModel::refreshSectionList()
     Q_EMIT sectionsChanged();
 }
 
-void AppsModel::processServiceGroup(KServiceGroup::Ptr group)
+void AppsModel::processServiceGroup(const QString &entryPath, QList<AbstractEntry *> &entryList)
 {
-    if (!group || !group->isValid()) {
-        return;
-    }
-
-    bool hasSubGroups = false;
-
-    const QList<KServiceGroup::Ptr> groupEntries = group->groupEntries(KServiceGroup::ExcludeNoDisplay);
-    for (KServiceGroup::Ptr subGroup : groupEntries) {
-        if (subGroup->childCount() > 0) {
-            hasSubGroups = true;
-
-            break;
-        }
-    }
+    const QSharedPointer<const AppsSnapshot> snapshot = AppsSnapshot::current();
+    const bool hasSubGroups = snapshot->hasSubGroups(entryPath);
 
     bool sortByGenericName = (appNameFormat() == AppEntry::GenericNameOnly || appNameFormat() == AppEntry::GenericNameAndName);
 
-    KServiceGroup::List list = group->entries(true /* sorted */,
-                                              true /* excludeNoDisplay */,
-                                              (!m_flat || (m_flat && !hasSubGroups)) /* allowSeparators */,
-                                              sortByGenericName /* sortByGenericName */);
+    const KServiceGroup::List list = snapshot->entries(entryPath,
+                                                       (!m_flat || (m_flat && !hasSubGroups)) /* allowSeparators */,
+                                                       sortByGenericName /* sortByGenericName */);
 
-    QStringList hiddenApps;
+    QSet<QString> hiddenApps;
 
     QObject *appletInterface = rootModel()->property("appletInterface").value<QObject *>();
     QQmlPropertyMap *appletConfig = nullptr;
@@ -671,7 +833,8 @@ void AppsModel::processServiceGroup(KServiceGroup::Ptr group)
         appletConfig = qobject_cast<QQmlPropertyMap *>(appletInterface->property("configuration").value<QObject *>());
     }
     if (appletConfig && appletConfig->contains(QStringLiteral("hiddenApplications"))) {
-        hiddenApps = appletConfig->value(QStringLiteral("hiddenApplications")).toStringList();
+        const QStringList hiddenApplications = appletConfig->value(QStringLiteral("hiddenApplications")).toStringList();
+        hiddenApps = QSet<QString>(hiddenApplications.cbegin(), hiddenApplications.cend());
     }
 
     for (KServiceGroup::List::ConstIterator it = list.constBegin(); it != list.constEnd(); it++) {
@@ -690,20 +853,19 @@ void AppsModel::processServiceGroup(KServiceGroup::Ptr group)
                 continue;
             }
 
-            if (!containsSameStorageId(m_entryList, service)) {
-                m_entryList << new AppEntry(this, service, m_appNameFormat);
+            if (!m_storageIds.contains(service->storageId())) {
+                entryList << appEntry(service);
             }
         } else if (p->isType(KST_KServiceSeparator) && m_showSeparators) {
-            if (!m_entryList.count()) {
+            if (!entryList.count()) {
                 continue;
             }
 
-            if (m_entryList.last()->type() == AbstractEntry::SeparatorType) {
+            if (entryList.last()->type() == AbstractEntry::SeparatorType) {
                 continue;
             }
 
-            m_entryList << new SeparatorEntry(this);
-            ++m_separatorCount;
+            entryList << separatorEntry();
         } else if (p->isType(KST_KServiceGroup)) {
             const KServiceGroup::Ptr subGroup(static_cast<KServiceGroup *>(p.data()));
 
@@ -713,11 +875,9 @@ void AppsModel::processServiceGroup(KServiceGroup::Ptr group)
 
             if (m_flat) {
                 m_sorted = true;
-                const KServiceGroup::Ptr serviceGroup(static_cast<KServiceGroup *>(p.data()));
-                processServiceGroup(serviceGroup);
+                processServiceGroup(subGroup->entryPath(), entryList);
             } else {
-                AppGroupEntry *groupEntry = new AppGroupEntry(this, subGroup, m_paginate, m_pageSize, m_flat, m_sorted, m_showSeparators, m_appNameFormat);
-                m_entryList << groupEntry;
+                entryList << appGroupEntry(subGroup);
             }
         }
     }
@@ -725,33 +885,53 @@ void AppsModel::processServiceGroup(KServiceGroup::Ptr group)
 
 void AppsModel::sortEntries(QList<AbstractEntry *> &entryList)
 {
-    QCollator c;
+    const QSharedPointer<const AppsSnapshot> snapshot = AppsSnapshot::current();
+
+    // Comparing sort keys is a lot cheaper than collating the strings, and all menus share them
+    struct SortItem {
+        AbstractEntry *entry;
+        AbstractEntry::EntryType type;
+        QString group;
+        QCollatorSortKey groupKey;
+        QCollatorSortKey nameKey;
+    };
 
-    std::sort(entryList.begin(), entryList.end(), [&c](AbstractEntry *a, AbstractEntry *b) {
-        if (a->type() != b->type()) {
-            return a->type() > b->type();
+    std::vector<SortItem> items;
+    items.reserve(entryList.size());
+    for (AbstractEntry *entry : std::as_const(entryList)) {
+        const QString group = entry->group();
+        items.push_back({entry, entry->type(), group, snapshot->sortKey(group), snapshot->sortKey(entry->name())});
+    }
+
+    std::sort(items.begin(), items.end(), [](const SortItem &a, const SortItem &b) {
+        if (a.type != b.type) {
+            return a.type > b.type;
         } else {
-            if (a->group() != b->group()) {
+            if (a.group != b.group) {
                 // Number group
-                if (a->group() == QLatin1Char('#')) {
+                if (a.group == QLatin1Char('#')) {
                     return true;
-                } else if (b->group() == QLatin1Char('#')) {
+                } else if (b.group == QLatin1Char('#')) {
                     return false;
                 }
 
                 // Symbol group
-                if (a->group() == QLatin1Char('&')) {
+                if (a.group == QLatin1Char('&')) {
                     return true;
-                } else if (b->group() == QLatin1Char('&')) {
+                } else if (b.group == QLatin1Char('&')) {
                     return false;
                 }
 
-                return c.compare(a->group(), b->group()) < 0;
+                return a.groupKey.compare(b.groupKey) < 0;
             } else {
-                return c.compare(a->name(), b->name()) < 0;
+                return a.nameKey.compare(b.nameKey) < 0;
             }
         }
     });
+
+    for (int i = 0; i < entryList.size(); ++i) {
+        entryList[i] = items[i].entry;
+    }
 }
 
 void AppsModel::entryChanged(AbstractEntry *entry)
@@ -10,7 +10,9 @@
 #include "abstractmodel.h"
 #include "appentry.h"
 
+#include <QHash>
 #include <QQmlParserStatus>
+#include <QSet>
 
 #include <KServiceGroup>
 
@@ -92,6 +94,17 @@ public:
 
     void entryChanged(AbstractEntry *entry) override;
 
+    /**
+     * Brings the entries up to date with the sycoca database, with row level changes
+     * instead of a model reset, keeping the entries of unchanged applications and submenus
+     */
+    void updateEntries();
+
+    /**
+     * Replaces the entries of a model created from an entry list, with row level changes
+     */
+    void setEntries(const QList<AbstractEntry *> &entryList);
+
     void classBegin() override;
     void componentComplete() override;
 
@@ -110,10 +123,15 @@ Q_SIGNALS:
 
 protected Q_SLOTS:
     void refresh() override;
+    virtual void refreshFromSycoca();
 
 protected:
     void refreshInternal();
     void sortEntries(QList<AbstractEntry *> &entryList);
+    // Builds the entries out of the sycoca database, taking over those of previousEntries which are still there
+    QList<AbstractEntry *> buildEntryList(const QList<AbstractEntry *> &previousEntries);
+    // Turns the rows [first, first + count) into entryList, deleting the entries which are gone if ownsEntries
+    void applyEntryList(const QList<AbstractEntry *> &entryList, int first, int count, bool ownsEntries);
 
     bool m_complete;
 
@@ -129,9 +147,13 @@ protected:
     QObject *m_appletInterface;
 
 private:
-    void processServiceGroup(KServiceGroup::Ptr group);
+    void processServiceGroup(const QString &entryPath, QList<AbstractEntry *> &entryList);
     void refreshSectionList();
 
+    AbstractEntry *appEntry(const KService::Ptr &service);
+    AbstractEntry *appGroupEntry(const KServiceGroup::Ptr &group);
+    AbstractEntry *separatorEntry();
+
     bool m_autoPopulate;
 
     QVariantList m_sectionList;
@@ -144,5 +166,9 @@ private:
     bool m_sorted;
     AppEntry::NameFormat m_appNameFormat;
     QStringList m_hiddenEntries;
+    // State of buildEntryList()
+    QSet<QString> m_storageIds;
+    QHash<QString, AbstractEntry *> m_reusableEntries;
+    QSet<AbstractEntry *> m_changedEntries;
     static MenuEntryEditor *m_menuEntryEditor;
 };
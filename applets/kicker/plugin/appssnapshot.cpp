@@ -0,0 +1,241 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "appssnapshot.h"
+#include "appentry.h"
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QLocale>
+
+#include <KIconLoader>
+#include <KSycoca>
+
+#ifdef HAVE_ICU
+#include <unicode/translit.h>
+#endif
+
+namespace
+{
+
+#ifdef HAVE_ICU
+std::unique_ptr<icu::Transliterator> getICUTransliterator(const QLocale &locale)
+{
+    // Only use transliterator for certain locales.
+    // Because application name is a localized string, it would be really rare to
+    // have Chinese/Japanese character on other locales. Even if that happens, it
+    // is ok to use to the old 1 character strategy instead of using transliterator.
+    icu::UnicodeString id;
+    if (locale.language() == QLocale::Japanese) {
+        id = "Katakana-Hiragana";
+    } else if (locale.language() == QLocale::Chinese) {
+        id = "Han-Latin; Latin-ASCII";
+    }
+    if (id.isEmpty()) {
+        return nullptr;
+    }
+    auto ue = UErrorCode::U_ZERO_ERROR;
+    auto transliterator = std::unique_ptr<icu::Transliterator>(icu::Transliterator::createInstance(id, UTRANS_FORWARD, ue));
+
+    if (ue != UErrorCode::U_ZERO_ERROR) {
+        return nullptr;
+    }
+
+    return transliterator;
+}
+#endif
+
+QString groupName(const QString &name)
+{
+    if (name.isEmpty()) {
+        return QString();
+    }
+
+    const QChar firstChar = name[0];
+
+    // Put all applications whose names begin with numbers in group #
+    if (firstChar.isDigit()) {
+        return QStringLiteral("#");
+    }
+
+    // Put all applications whose names begin with punctuations/symbols/spaces in group &
+    if (firstChar.isPunct() || firstChar.isSymbol() || firstChar.isSpace()) {
+        return QStringLiteral("&");
+    }
+
+    // Here we will apply a locale based strategy for the first character.
+    // If first character is hangul, run decomposition and return the choseong (consonants).
+    if (firstChar.script() == QChar::Script_Hangul) {
+        auto decomposed = firstChar.decomposition();
+        if (decomposed.isEmpty()) {
+            return name.left(1);
+        }
+        return decomposed.left(1);
+    }
+    const auto locale = QLocale::system();
+    if (locale.language() == QLocale::Japanese) {
+        // We do this here for Japanese locale because:
+        // 1. it does not make much sense to have every different Kanji to have a different group.
+        // 2. ICU transliterator can't yet convert Kanji to Hiragana.
+        //    https://unicode-org.atlassian.net/browse/ICU-5874
+        if (firstChar.script() == QChar::Script_Han) {
+            // Unicode Han
+            return QString::fromUtf8("\xe6\xbc\xa2");
+        }
+    }
+#ifdef HAVE_ICU
+    // Precondition to use transliterator.
+    if ((locale.language() == QLocale::Chinese && firstChar.script() == QChar::Script_Han)
+        || (locale.language() == QLocale::Japanese && firstChar.script() == QChar::Script_Katakana)) {
+        static auto transliterator = getICUTransliterator(locale);
+
+        if (transliterator) {
+            icu::UnicodeString icuText(reinterpret_cast<const char16_t *>(name.data()), name.size());
+            transliterator->transliterate(icuText);
+            return QString::fromUtf16(icuText.getBuffer(), static_cast<int>(icuText.length())).left(1);
+        }
+    }
+#endif
+    return name.left(1);
+}
+}
+
+static QSharedPointer<const AppsSnapshot> s_currentSnapshot;
+
+AppsSnapshotWatcher::AppsSnapshotWatcher()
+{
+    // Not along with the static objects, the icons and services need the application
+    qAddPostRoutine([]() {
+        s_currentSnapshot.reset();
+    });
+
+    connect(KSycoca::self(), &KSycoca::databaseChanged, this, [this]() {
+        s_currentSnapshot.reset();
+        Q_EMIT changed();
+    });
+
+    // Whether the theme has an icon or the fallback is used may differ in the new theme
+    connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged, this, []() {
+        if (s_currentSnapshot) {
+            s_currentSnapshot->clearIcons();
+        }
+    });
+}
+
+AppsSnapshotWatcher *AppsSnapshotWatcher::self()
+{
+    static AppsSnapshotWatcher watcher;
+    return &watcher;
+}
+
+AppsSnapshot::AppsSnapshot() = default;
+
+QSharedPointer<const AppsSnapshot> AppsSnapshot::current()
+{
+    // Make sure a database change drops the snapshot
+    AppsSnapshotWatcher::self();
+
+    if (!s_currentSnapshot) {
+        s_currentSnapshot.reset(new AppsSnapshot);
+    }
+    return s_currentSnapshot;
+}
+
+AppsSnapshot::Application AppsSnapshot::application(const KService::Ptr &service, int nameFormat) const
+{
+    const QString key = QString::number(nameFormat) + QLatin1Char(':') + service->storageId();
+
+    auto it = m_applications.constFind(key);
+    if (it != m_applications.constEnd()) {
+        return *it;
+    }
+
+    const auto format = static_cast<AppEntry::NameFormat>(nameFormat);
+    Application application;
+    application.name = AppEntry::nameFromService(service, format);
+    application.description = AppEntry::nameFromService(service, format == AppEntry::GenericNameOnly ? AppEntry::NameOnly : AppEntry::GenericNameOnly);
+    application.group = groupName(application.name);
+    if (application.group.isNull()) {
+        application.group = QLatin1String("");
+    }
+
+    m_applications.insert(key, application);
+    return application;
+}
+
+KServiceGroup::List AppsSnapshot::entries(const QString &entryPath, bool allowSeparators, bool sortByGenericName) const
+{
+    const QString key = QString::number(allowSeparators) + QString::number(sortByGenericName) + entryPath;
+
+    auto it = m_entries.constFind(key);
+    if (it != m_entries.constEnd()) {
+        return *it;
+    }
+
+    KServiceGroup::List list;
+    const KServiceGroup::Ptr group = entryPath.isEmpty() ? KServiceGroup::root() : KServiceGroup::group(entryPath);
+    if (group && group->isValid()) {
+        list = group->entries(true /* sorted */, true /* excludeNoDisplay */, allowSeparators, sortByGenericName);
+    }
+
+    m_entries.insert(key, list);
+    return list;
+}
+
+bool AppsSnapshot::hasSubGroups(const QString &entryPath) const
+{
+    auto it = m_hasSubGroups.constFind(entryPath);
+    if (it != m_hasSubGroups.constEnd()) {
+        return *it;
+    }
+
+    bool hasSubGroups = false;
+    const KServiceGroup::Ptr group = entryPath.isEmpty() ? KServiceGroup::root() : KServiceGroup::group(entryPath);
+    if (group && group->isValid()) {
+        const QList<KServiceGroup::Ptr> groupEntries = group->groupEntries(KServiceGroup::ExcludeNoDisplay);
+        hasSubGroups = std::any_of(groupEntries.cbegin(), groupEntries.cend(), [](const KServiceGroup::Ptr &subGroup) {
+            return subGroup->childCount() > 0;
+        });
+    }
+
+    m_hasSubGroups.insert(entryPath, hasSubGroups);
+    return hasSubGroups;
+}
+
+QIcon AppsSnapshot::icon(const QString &iconName) const
+{
+    auto it = m_icons.constFind(iconName);
+    if (it != m_icons.constEnd()) {
+        return *it;
+    }
+
+    QIcon icon;
+    if (QFileInfo::exists(iconName)) {
+        icon = QIcon(iconName);
+    } else {
+        icon = QIcon::fromTheme(iconName, QIcon::fromTheme(QStringLiteral("unknown")));
+    }
+
+    m_icons.insert(iconName, icon);
+    return icon;
+}
+
+void AppsSnapshot::clearIcons() const
+{
+    m_icons.clear();
+}
+
+QCollatorSortKey AppsSnapshot::sortKey(const QString &text) const
+{
+    auto it = m_sortKeys.constFind(text);
+    if (it != m_sortKeys.constEnd()) {
+        return *it;
+    }
+
+    return *m_sortKeys.insert(text, m_collator.sortKey(text));
+}
@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QCollator>
+#include <QHash>
+#include <QIcon>
+#include <QObject>
+#include <QSharedPointer>
+
+#include <KService>
+#include <KServiceGroup>
+
+/**
+ * What the application menus of all Kicker, Kickoff and Dashboard instances of the process
+ * show, read out of one version of the sycoca database.
+ *
+ * Everything is worked out on first use and cached in the snapshot, which all the instances
+ * share: the menu listings, the names and sections of the applications, their sort keys and
+ * their icons. The caches are filled by the const accessors without any locking, so like the
+ * models a snapshot may only be used from the GUI thread.
+ *
+ * After a database change current() returns a new snapshot, and AppsSnapshotWatcher::changed()
+ * tells the models to move over to it. The sort keys follow the locale the snapshot was made
+ * with, the icons are looked up again after an icon theme change.
+ */
+class AppsSnapshot
+{
+public:
+    static QSharedPointer<const AppsSnapshot> current();
+
+    struct Application {
+        QString name;
+        QString description;
+        // The section in alphabetical lists, the first character of the transliterated name
+        QString group;
+    };
+
+    /**
+     * @param nameFormat an AppEntry::NameFormat
+     */
+    Application application(const KService::Ptr &service, int nameFormat) const;
+
+    /**
+     * The sorted entries of the menu at @p entryPath without the hidden ones, the root menu for an empty one
+     */
+    KServiceGroup::List entries(const QString &entryPath, bool allowSeparators, bool sortByGenericName) const;
+    bool hasSubGroups(const QString &entryPath) const;
+
+    /**
+     * @p iconName may also be the path of an image
+     */
+    QIcon icon(const QString &iconName) const;
+
+    QCollatorSortKey sortKey(const QString &text) const;
+
+private:
+    AppsSnapshot();
+    void clearIcons() const;
+
+    friend class AppsSnapshotWatcher;
+
+    const QCollator m_collator;
+    mutable QHash<QString, Application> m_applications;
+    mutable QHash<QString, KServiceGroup::List> m_entries;
+    mutable QHash<QString, bool> m_hasSubGroups;
+    mutable QHash<QString, QIcon> m_icons;
+    mutable QHash<QString, QCollatorSortKey> m_sortKeys;
+};
+
+class AppsSnapshotWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AppsSnapshotWatcher *self();
+
+Q_SIGNALS:
+    /**
+     * The sycoca database changed, AppsSnapshot::current() returns a new snapshot
+     */
+    void changed();
+
+private:
+    AppsSnapshotWatcher();
+};
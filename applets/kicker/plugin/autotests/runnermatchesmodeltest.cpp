@@ -0,0 +1,163 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QtTest>
+
+#include <KRunner/QueryMatch>
+
+#include "../runnermatchesmodel.h"
+
+class RunnerMatchesModelTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testSetMatches_data();
+    void testSetMatches();
+    void testPersistentRows();
+    void testRefineMatches_data();
+    void testRefineMatches();
+};
+
+// Space separated entries of "id", or "id=text" for matches whose text is not their id
+static QList<Plasma::QueryMatch> createMatches(const QString &entries)
+{
+    QList<Plasma::QueryMatch> matches;
+    const QStringList entryList = entries.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    for (const QString &entry : entryList) {
+        const QStringList parts = entry.split(QLatin1Char('='));
+        Plasma::QueryMatch match(nullptr);
+        match.setId(parts.constFirst());
+        match.setText(parts.constLast());
+        matches << match;
+    }
+    return matches;
+}
+
+// The texts of all rows, space separated
+static QString texts(const QAbstractItemModel &model)
+{
+    QStringList ret;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        ret << model.index(row, 0).data(Qt::DisplayRole).toString();
+    }
+    return ret.join(QLatin1Char(' '));
+}
+
+void RunnerMatchesModelTest::testSetMatches_data()
+{
+    QTest::addColumn<QString>("before");
+    QTest::addColumn<QString>("after");
+    QTest::addColumn<int>("inserted");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<int>("moved");
+    QTest::addColumn<int>("changed");
+
+    QTest::newRow("unchanged") << QStringLiteral("a b c") << QStringLiteral("a b c") << 0 << 0 << 0 << 0;
+    QTest::newRow("remove in the middle") << QStringLiteral("a b c") << QStringLiteral("a c") << 0 << 1 << 0 << 0;
+    QTest::newRow("insert in the middle") << QStringLiteral("a c") << QStringLiteral("a b c") << 1 << 0 << 0 << 0;
+    QTest::newRow("remove at the front, append") << QStringLiteral("a b c") << QStringLiteral("b c d") << 1 << 1 << 0 << 0;
+    QTest::newRow("move to the front") << QStringLiteral("a b c") << QStringLiteral("c a b") << 0 << 0 << 1 << 0;
+    QTest::newRow("swap") << QStringLiteral("a b c") << QStringLiteral("b a c") << 0 << 0 << 1 << 0;
+    QTest::newRow("replace all") << QStringLiteral("a b") << QStringLiteral("c d") << 2 << 2 << 0 << 0;
+    QTest::newRow("text changed") << QStringLiteral("a=Alpha b") << QStringLiteral("a=Apple b") << 0 << 0 << 0 << 1;
+    // Duplicate ids are told apart by their occurrence
+    QTest::newRow("duplicate removed") << QStringLiteral("a=One a=Two b") << QStringLiteral("a=One b") << 0 << 1 << 0 << 0;
+    QTest::newRow("duplicate appended") << QStringLiteral("a b") << QStringLiteral("a b a") << 1 << 0 << 0 << 0;
+    QTest::newRow("duplicate changed") << QStringLiteral("a=One a=Two") << QStringLiteral("a=One a=Three") << 0 << 0 << 0 << 1;
+}
+
+void RunnerMatchesModelTest::testSetMatches()
+{
+    QFETCH(QString, before);
+    QFETCH(QString, after);
+    QFETCH(int, inserted);
+    QFETCH(int, removed);
+    QFETCH(int, moved);
+    QFETCH(int, changed);
+
+    RunnerMatchesModel model(QStringLiteral("test"), QStringLiteral("Test"), nullptr);
+    QAbstractItemModelTester tester(&model);
+
+    const QList<Plasma::QueryMatch> beforeMatches = createMatches(before);
+    model.setMatches(beforeMatches);
+    QCOMPARE(model.rowCount(), beforeMatches.count());
+
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy movedSpy(&model, &QAbstractItemModel::rowsMoved);
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+
+    const QList<Plasma::QueryMatch> afterMatches = createMatches(after);
+    model.setMatches(afterMatches);
+
+    QStringList expectedTexts;
+    for (const Plasma::QueryMatch &match : afterMatches) {
+        expectedTexts << match.text();
+    }
+    QCOMPARE(texts(model), expectedTexts.join(QLatin1Char(' ')));
+
+    QCOMPARE(insertedSpy.count(), inserted);
+    QCOMPARE(removedSpy.count(), removed);
+    QCOMPARE(movedSpy.count(), moved);
+    QCOMPARE(changedSpy.count(), changed);
+    QCOMPARE(resetSpy.count(), 0);
+}
+
+void RunnerMatchesModelTest::testPersistentRows()
+{
+    RunnerMatchesModel model(QStringLiteral("test"), QStringLiteral("Test"), nullptr);
+    QAbstractItemModelTester tester(&model);
+
+    model.setMatches(createMatches(QStringLiteral("a b c d")));
+    const QPersistentModelIndex a = model.index(0, 0);
+    const QPersistentModelIndex b = model.index(1, 0);
+    const QPersistentModelIndex c = model.index(2, 0);
+
+    model.setMatches(createMatches(QStringLiteral("d b e a")));
+    QCOMPARE(texts(model), QStringLiteral("d b e a"));
+
+    // Rows follow their match
+    QCOMPARE(a.row(), 3);
+    QCOMPARE(a.data().toString(), QStringLiteral("a"));
+    QCOMPARE(b.row(), 1);
+    QCOMPARE(b.data().toString(), QStringLiteral("b"));
+    QVERIFY(!c.isValid());
+}
+
+void RunnerMatchesModelTest::testRefineMatches_data()
+{
+    QTest::addColumn<QString>("previousQuery");
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("extended term") << QStringLiteral("fire") << QStringLiteral("firef") << QStringLiteral("Firefox 42");
+    QTest::newRow("case insensitive") << QStringLiteral("fire") << QStringLiteral("FireW") << QStringLiteral("Firewall 42");
+    // Runners match words one by one, "fire f" may well still find Firewall
+    QTest::newRow("second word") << QStringLiteral("fire") << QStringLiteral("fire f") << QStringLiteral("Firefox Firewall 42");
+}
+
+void RunnerMatchesModelTest::testRefineMatches()
+{
+    QFETCH(QString, previousQuery);
+    QFETCH(QString, query);
+    QFETCH(QString, expected);
+
+    RunnerMatchesModel model(QStringLiteral("test"), QStringLiteral("Test"), nullptr);
+    QAbstractItemModelTester tester(&model);
+
+    // 42 stands for a match which was not found by its text, like a calculation
+    model.setMatches(createMatches(QStringLiteral("firefox=Firefox firewall=Firewall calc=42")));
+    model.refineMatches(previousQuery, query);
+
+    QCOMPARE(texts(model), expected);
+}
+
+QTEST_MAIN(RunnerMatchesModelTest)
+
+#include "runnermatchesmodeltest.moc"
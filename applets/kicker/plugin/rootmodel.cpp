@@ -282,6 +282,7 @@ void RootModel::refresh()
     beginResetModel();
 
     AppsModel::refreshInternal();
+    m_appEntriesCount = m_entryList.count();
 
     AppsModel *allModel = nullptr;
     m_recentAppsModel = nullptr;
@@ -289,36 +290,11 @@ void RootModel::refresh()
     m_recentContactsModel = nullptr;
 
     if (m_showAllApps) {
-        QHash<QString, AbstractEntry *> appsHash;
-
-        std::function<void(AbstractEntry *)> processEntry = [&](AbstractEntry *entry) {
-            if (entry->type() == AbstractEntry::RunnableType) {
-                AppEntry *appEntry = static_cast<AppEntry *>(entry);
-                appsHash.insert(appEntry->service()->menuId(), appEntry);
-            } else if (entry->type() == AbstractEntry::GroupType) {
-                GroupEntry *groupEntry = static_cast<GroupEntry *>(entry);
-                AbstractModel *model = groupEntry->childModel();
-
-                if (!model) {
-                    return;
-                }
-
-                for (int i = 0; i < model->count(); ++i) {
-                    processEntry(static_cast<AbstractEntry *>(model->index(i, 0).internalPointer()));
-                }
-            }
-        };
-
-        for (AbstractEntry *entry : qAsConst(m_entryList)) {
-            processEntry(entry);
-        }
-
-        QList<AbstractEntry *> apps(appsHash.values());
-        sortEntries(apps);
-
         if (!m_showAllAppsCategorized && !m_paginate) { // The app list built above goes into a model.
-            allModel = new AppsModel(apps, false, this);
+            allModel = new AppsModel(allApps(m_entryList), false, this);
         } else if (m_paginate) { // We turn the apps list into a subtree of pages.
+            const QList<AbstractEntry *> apps = allApps(m_entryList);
+
             m_favorites = new KAStatsFavoritesModel(this);
             Q_EMIT favoritesModelChanged();
 
@@ -350,48 +326,14 @@ void RootModel::refresh()
 
             allModel = new AppsModel(groups, true, this);
         } else { // We turn the apps list into a subtree of apps by starting letter.
-            QList<AbstractEntry *> groups;
-            QHash<QString, QList<AbstractEntry *>> m_categoryHash;
-
-            for (const AbstractEntry *groupEntry : std::as_const(m_entryList)) {
-                AbstractModel *model = groupEntry->childModel();
-
-                if (!model)
-                    continue;
-
-                for (int i = 0; i < model->count(); ++i) {
-                    AbstractEntry *appEntry = static_cast<AbstractEntry *>(model->index(i, 0).internalPointer());
-
-                    // App entry's group stores a transliterated first character of the name. Prefer to use that.
-                    QString name = appEntry->group();
-                    if (name.isEmpty()) {
-                        name = appEntry->name();
-                    }
-
-                    if (name.isEmpty()) {
-                        continue;
-                    }
-
-                    const QChar &first = name.at(0).toUpper();
-                    m_categoryHash[first.isDigit() ? QStringLiteral("0-9") : first].append(appEntry);
-                }
-            }
-
-            QHashIterator<QString, QList<AbstractEntry *>> i(m_categoryHash);
-
-            while (i.hasNext()) {
-                i.next();
-                AppsModel *model = new AppsModel(i.value(), false, this);
-                model->setDescription(i.key());
-                groups.append(new GroupEntry(this, i.key(), QString(), model));
-            }
-
-            allModel = new AppsModel(groups, true, this);
+            allModel = new AppsModel(categorizedApps(m_entryList, QList<AbstractEntry *>()), true, this);
         }
 
         allModel->setDescription(QStringLiteral("KICKER_ALL_MODEL")); // Intentionally no i18n.
     }
 
+    m_allAppsModel = allModel;
+
     int separatorPosition = 0;
 
     if (allModel) {
@@ -441,9 +383,12 @@ void RootModel::refresh()
         ++separatorPosition;
     }
 
+    m_appEntriesFirst = separatorPosition;
+
     if (m_showSeparators && separatorPosition > 0) {
         m_entryList.insert(separatorPosition, new SeparatorEntry(this));
         ++m_separatorCount;
+        ++m_appEntriesFirst;
     }
 
     m_systemModel = new SystemModel(this);
@@ -463,3 +408,133 @@ void RootModel::refresh()
 
     Q_EMIT refreshed();
 }
+
+void RootModel::refreshFromSycoca()
+{
+    if (!m_complete) {
+        return;
+    }
+
+    // The pages of all applications are cut out of the sorted list, one application more or less shifts all of them
+    if (m_paginate) {
+        refresh();
+        return;
+    }
+
+    const int oldCount = m_entryList.count();
+    const int oldSeparatorCount = m_separatorCount;
+    const bool hasOwnSeparator = m_appEntriesFirst > 0 && m_entryList.at(m_appEntriesFirst - 1)->type() == AbstractEntry::SeparatorType;
+
+    const QList<AbstractEntry *> entries = buildEntryList(m_entryList.mid(m_appEntriesFirst, m_appEntriesCount));
+    if (hasOwnSeparator) {
+        ++m_separatorCount;
+    }
+    applyEntryList(entries, m_appEntriesFirst, m_appEntriesCount, true);
+    m_appEntriesCount = entries.count();
+
+    if (m_allAppsModel) {
+        if (m_showAllAppsCategorized) {
+            QList<AbstractEntry *> previousGroups;
+            for (int i = 0; i < m_allAppsModel->count(); ++i) {
+                previousGroups << static_cast<AbstractEntry *>(m_allAppsModel->index(i, 0).internalPointer());
+            }
+            m_allAppsModel->setEntries(categorizedApps(entries, previousGroups));
+        } else {
+            m_allAppsModel->setEntries(allApps(entries));
+        }
+    }
+
+    m_favorites->refresh();
+
+    if (m_entryList.count() != oldCount) {
+        Q_EMIT countChanged();
+    }
+    if (m_separatorCount != oldSeparatorCount) {
+        Q_EMIT separatorCountChanged();
+    }
+}
+
+QList<AbstractEntry *> RootModel::allApps(const QList<AbstractEntry *> &appEntries)
+{
+    QHash<QString, AbstractEntry *> appsHash;
+
+    std::function<void(AbstractEntry *)> processEntry = [&](AbstractEntry *entry) {
+        if (entry->type() == AbstractEntry::RunnableType) {
+            AppEntry *appEntry = static_cast<AppEntry *>(entry);
+            appsHash.insert(appEntry->service()->menuId(), appEntry);
+        } else if (entry->type() == AbstractEntry::GroupType) {
+            AbstractModel *model = entry->childModel();
+
+            if (!model) {
+                return;
+            }
+
+            for (int i = 0; i < model->count(); ++i) {
+                processEntry(static_cast<AbstractEntry *>(model->index(i, 0).internalPointer()));
+            }
+        }
+    };
+
+    for (AbstractEntry *entry : appEntries) {
+        processEntry(entry);
+    }
+
+    QList<AbstractEntry *> apps(appsHash.values());
+    sortEntries(apps);
+    return apps;
+}
+
+QList<AbstractEntry *> RootModel::categorizedApps(const QList<AbstractEntry *> &appEntries, const QList<AbstractEntry *> &previousGroups)
+{
+    QList<AbstractEntry *> groups;
+    QHash<QString, QList<AbstractEntry *>> m_categoryHash;
+
+    for (const AbstractEntry *groupEntry : appEntries) {
+        AbstractModel *model = groupEntry->childModel();
+
+        if (!model)
+            continue;
+
+        for (int i = 0; i < model->count(); ++i) {
+            AbstractEntry *appEntry = static_cast<AbstractEntry *>(model->index(i, 0).internalPointer());
+
+            // App entry's group stores a transliterated first character of the name. Prefer to use that.
+            QString name = appEntry->group();
+            if (name.isEmpty()) {
+                name = appEntry->name();
+            }
+
+            if (name.isEmpty()) {
+                continue;
+            }
+
+            const QChar &first = name.at(0).toUpper();
+            m_categoryHash[first.isDigit() ? QStringLiteral("0-9") : first].append(appEntry);
+        }
+    }
+
+    QHash<QString, AbstractEntry *> previousGroupsByName;
+    for (AbstractEntry *groupEntry : previousGroups) {
+        previousGroupsByName.insert(groupEntry->name(), groupEntry);
+    }
+
+    QHashIterator<QString, QList<AbstractEntry *>> i(m_categoryHash);
+
+    while (i.hasNext()) {
+        i.next();
+
+        AbstractEntry *groupEntry = previousGroupsByName.value(i.key());
+        AppsModel *model = groupEntry ? qobject_cast<AppsModel *>(groupEntry->childModel()) : nullptr;
+
+        if (model) {
+            model->setEntries(i.value());
+            groups.append(groupEntry);
+        } else {
+            model = new AppsModel(i.value(), false, this);
+            model->setDescription(i.key());
+            groups.append(new GroupEntry(this, i.key(), QString(), model));
+        }
+    }
+
+    return groups;
+}
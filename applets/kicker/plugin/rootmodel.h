@@ -96,8 +96,14 @@ Q_SIGNALS:
 
 protected Q_SLOTS:
     void refresh() override;
+    void refreshFromSycoca() override;
 
 private:
+    // The applications of the submenus in appEntries, sorted
+    QList<AbstractEntry *> allApps(const QList<AbstractEntry *> &appEntries);
+    // The applications of the submenus in appEntries grouped by first letter, taking over the groups of previousGroups
+    QList<AbstractEntry *> categorizedApps(const QList<AbstractEntry *> &appEntries, const QList<AbstractEntry *> &previousGroups);
+
     KAStatsFavoritesModel *m_favorites;
     SystemModel *m_systemModel;
 
@@ -113,4 +119,9 @@ private:
     RecentUsageModel *m_recentAppsModel;
     RecentUsageModel *m_recentDocsModel;
     RecentContactsModel *m_recentContactsModel;
+
+    // The rows AppsModel fills in, between the recent items and the system entries
+    int m_appEntriesFirst = 0;
+    int m_appEntriesCount = 0;
+    QPointer<AppsModel> m_allAppsModel;
 };
@@ -10,7 +10,9 @@
 #include "runnermodel.h"
 
 #include <QAction>
+#include <QHash>
 #include <QIcon>
+#include <QSet>
 #include <QUrlQuery>
 
 #include <KIO/CommandLauncherJob>
@@ -19,6 +21,42 @@
 
 #include <Plasma/Plasma>
 
+#include <algorithm>
+
+// Runners create new matches for every query, their ids tell which ones are still the same.
+// Ids need not be unique, e.g. some runners use their own id, so the occurrence is part of the key.
+static QStringList matchKeys(const QList<Plasma::QueryMatch> &matches)
+{
+    QStringList keys;
+    keys.reserve(matches.count());
+    QHash<QString, int> occurrences;
+
+    for (const Plasma::QueryMatch &match : matches) {
+        const QString id = match.id();
+        keys << id + QLatin1Char('#') + QString::number(occurrences[id]++);
+    }
+
+    return keys;
+}
+
+static bool isDisplayedAlike(const Plasma::QueryMatch &a, const Plasma::QueryMatch &b)
+{
+    if (a.text() != b.text() || a.subtext() != b.subtext() || a.iconName() != b.iconName() || a.isMultiLine() != b.isMultiLine()) {
+        return false;
+    }
+
+    if (a.iconName().isEmpty() && a.icon().cacheKey() != b.icon().cacheKey()) {
+        return false;
+    }
+
+    return a.urls() == b.urls() && a.data() == b.data();
+}
+
+static bool containsTerm(const Plasma::QueryMatch &match, const QString &term)
+{
+    return match.text().contains(term, Qt::CaseInsensitive) || match.subtext().contains(term, Qt::CaseInsensitive);
+}
+
 RunnerMatchesModel::RunnerMatchesModel(const QString &runnerId, const QString &name, Plasma::RunnerManager *manager, QObject *parent)
     : AbstractModel(parent)
     , m_runnerId(runnerId)
@@ -226,41 +264,81 @@ bool RunnerMatchesModel::trigger(int row, const QString &actionId, const QVarian
 
 void RunnerMatchesModel::setMatches(const QList<Plasma::QueryMatch> &matches)
 {
-    int oldCount = m_matches.count();
-    int newCount = matches.count();
+    const int oldCount = m_matches.count();
+    const QStringList keys = matchKeys(matches);
+    const QSet<QString> kept(keys.cbegin(), keys.cend());
+
+    // From the back so the rows in front stay valid
+    for (int row = m_matches.count() - 1; row >= 0; --row) {
+        if (kept.contains(m_matchKeys.at(row))) {
+            continue;
+        }
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_matches.removeAt(row);
+        m_matchKeys.removeAt(row);
+        endRemoveRows();
+    }
 
-    bool emitCountChange = (oldCount != newCount);
+    // What is left of the old rows is in matches too, in front of row everything is in place
+    for (int row = 0; row < matches.count(); ++row) {
+        const QString &key = keys.at(row);
 
-    int ceiling = qMin(oldCount, newCount);
-    bool emitDataChange = false;
+        if (row >= m_matchKeys.count() || m_matchKeys.at(row) != key) {
+            const int from = m_matchKeys.indexOf(key, row);
 
-    for (int row = 0; row < ceiling; ++row) {
-        if (!(m_matches.at(row) == matches.at(row))) {
-            emitDataChange = true;
-            m_matches[row] = matches.at(row);
+            if (from == -1) {
+                beginInsertRows(QModelIndex(), row, row);
+                m_matches.insert(row, matches.at(row));
+                m_matchKeys.insert(row, key);
+                endInsertRows();
+                continue;
+            }
+
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+            m_matches.move(from, row);
+            m_matchKeys.move(from, row);
+            endMoveRows();
         }
-    }
 
-    if (emitDataChange) {
-        Q_EMIT dataChanged(index(0, 0), index(ceiling - 1, 0));
+        const bool changed = !isDisplayedAlike(m_matches.at(row), matches.at(row));
+        m_matches[row] = matches.at(row);
+
+        if (changed) {
+            Q_EMIT dataChanged(index(row, 0), index(row, 0));
+        }
     }
 
-    if (newCount > oldCount) {
-        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+    Q_ASSERT(m_matches.count() == matches.count());
 
-        m_matches = matches;
+    if (m_matches.count() != oldCount) {
+        Q_EMIT countChanged();
+    }
+}
 
-        endInsertRows();
-    } else if (newCount < oldCount) {
-        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+void RunnerMatchesModel::refineMatches(const QString &previousQuery, const QString &query)
+{
+    // Runners match the words of a query one by one, e.g. "fire f" still finds "Firefox",
+    // which a plain substring test can't tell. Leave such queries to the runners.
+    if (std::any_of(query.cbegin(), query.cend(), [](QChar c) {
+            return c.isSpace();
+        })) {
+        return;
+    }
 
-        m_matches = matches;
+    // Whatever was not found by its text, e.g. by a keyword or a calculation, waits for the runners
+    QList<Plasma::QueryMatch> matches;
+    matches.reserve(m_matches.count());
 
-        endRemoveRows();
+    for (const Plasma::QueryMatch &match : std::as_const(m_matches)) {
+        if (containsTerm(match, previousQuery) && !containsTerm(match, query)) {
+            continue;
+        }
+        matches << match;
     }
 
-    if (emitCountChange) {
-        Q_EMIT countChanged();
+    if (matches.count() != m_matches.count()) {
+        setMatches(matches);
     }
 }
 
@@ -42,8 +42,18 @@ public:
         return m_name;
     }
 
+    /**
+     * Applies the difference to the current matches row by row, matches keep their row
+     * for as long as their id is there
+     */
     void setMatches(const QList<Plasma::QueryMatch> &matches);
 
+    /**
+     * Drops the matches which were found by their text and no longer contain @p query,
+     * when @p query extends @p previousQuery and is still a single word
+     */
+    void refineMatches(const QString &previousQuery, const QString &query);
+
     AbstractModel *favoritesModel() override;
 
 private:
@@ -51,4 +61,6 @@ private:
     QString m_name;
     Plasma::RunnerManager *m_runnerManager;
     QList<Plasma::QueryMatch> m_matches;
+    // The identity of the match in the same row, see matchKeys()
+    QStringList m_matchKeys;
 };
@@ -177,8 +177,14 @@ QString RunnerModel::query() const
 void RunnerModel::setQuery(const QString &query)
 {
     if (m_query != query) {
+        const QString previousQuery = m_query.trimmed();
         m_query = query;
 
+        // The runners take a while to reply, meanwhile show what is left of the results for the shorter query
+        if (!previousQuery.isEmpty() && query.trimmed().startsWith(previousQuery, Qt::CaseInsensitive)) {
+            refineMatches(previousQuery);
+        }
+
         m_queryTimer.start();
 
         Q_EMIT queryChanged();
@@ -321,6 +327,24 @@ void RunnerModel::matchesChanged(const QList<Plasma::QueryMatch> &matches)
     }
 }
 
+void RunnerModel::refineMatches(const QString &previousQuery)
+{
+    const QString query = m_query.trimmed();
+
+    for (int row = m_models.count() - 1; row >= 0; --row) {
+        RunnerMatchesModel *matchesModel = m_models.at(row);
+        matchesModel->refineMatches(previousQuery, query);
+
+        if (!m_mergeResults && m_deleteWhenEmpty && matchesModel->rowCount() == 0) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_models.removeAt(row);
+            delete matchesModel;
+            endRemoveRows();
+            Q_EMIT countChanged();
+        }
+    }
+}
+
 void RunnerModel::createManager()
 {
     if (!m_runnerManager) {
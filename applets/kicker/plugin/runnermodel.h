@@ -80,6 +80,7 @@ private Q_SLOTS:
 private:
     void createManager();
     void clear();
+    void refineMatches(const QString &previousQuery);
 
     AbstractModel *m_favoritesModel = nullptr;
     QObject *m_appletInterface = nullptr;
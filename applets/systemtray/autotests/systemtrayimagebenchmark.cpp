@@ -0,0 +1,78 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QtTest>
+
+#include "systemtrayimage.h"
+
+Q_DECLARE_METATYPE(Simd::Kernel)
+
+class SystemTrayImageBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkConversion_data();
+    void benchmarkConversion();
+    void benchmarkToImage_data();
+    void benchmarkToImage();
+};
+
+// The usual sizes of tray icons, and what some applications send anyway
+static const int s_iconSizes[] = {16, 22, 32, 64, 256};
+
+void SystemTrayImageBenchmark::benchmarkConversion_data()
+{
+    QTest::addColumn<Simd::Kernel>("kernel");
+    QTest::addColumn<int>("size");
+
+    const QVector<Simd::Kernel> kernels = Simd::supportedKernels();
+    for (Simd::Kernel kernel : kernels) {
+        for (int size : s_iconSizes) {
+            QTest::addRow("%s-%dx%d", Simd::name(kernel), size, size) << kernel << size;
+        }
+    }
+}
+
+void SystemTrayImageBenchmark::benchmarkConversion()
+{
+    QFETCH(Simd::Kernel, kernel);
+    QFETCH(int, size);
+
+    const QByteArray data(size * size * 4, '\x7f');
+    QVector<quint32> pixels(size * size);
+
+    QBENCHMARK {
+        SystemTrayImage::argbFromBigEndian(reinterpret_cast<const uchar *>(data.constData()), pixels.data(), pixels.size(), kernel);
+    }
+}
+
+void SystemTrayImageBenchmark::benchmarkToImage_data()
+{
+    QTest::addColumn<int>("size");
+
+    for (int size : s_iconSizes) {
+        QTest::addRow("%dx%d", size, size) << size;
+    }
+}
+
+void SystemTrayImageBenchmark::benchmarkToImage()
+{
+    QFETCH(int, size);
+
+    KDbusImageStruct image;
+    image.width = size;
+    image.height = size;
+    image.data = QByteArray(size * size * 4, '\x7f');
+
+    QBENCHMARK {
+        const QImage decoded = SystemTrayImage::toImage(image);
+        Q_UNUSED(decoded)
+    }
+}
+
+QTEST_GUILESS_MAIN(SystemTrayImageBenchmark)
+
+#include "systemtrayimagebenchmark.moc"
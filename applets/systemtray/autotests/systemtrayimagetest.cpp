@@ -0,0 +1,147 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <QtTest>
+
+#include "systemtrayimage.h"
+
+Q_DECLARE_METATYPE(Simd::Kernel)
+
+class SystemTrayImageTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPixelOrder();
+    void testConversion_data();
+    void testConversion();
+    void testDecodeTwice();
+    void testInvalidImage_data();
+    void testInvalidImage();
+    void testIcon();
+};
+
+static KDbusImageStruct imageStruct(int width, int height, const QByteArray &data)
+{
+    KDbusImageStruct image;
+    image.width = width;
+    image.height = height;
+    image.data = data;
+    return image;
+}
+
+static QByteArray randomPixels(int count)
+{
+    QByteArray data(count * 4, Qt::Uninitialized);
+    for (char &byte : data) {
+        byte = static_cast<char>(QRandomGenerator::global()->bounded(256));
+    }
+    return data;
+}
+
+void SystemTrayImageTest::testPixelOrder()
+{
+    // Network byte order: alpha, red, green, blue
+    const QByteArray data = QByteArray::fromHex("80ff4020" "ff000000" "00000000" "ff0000ff");
+    const QImage image = SystemTrayImage::toImage(imageStruct(2, 2, data));
+
+    QCOMPARE(image.size(), QSize(2, 2));
+    QCOMPARE(image.format(), QImage::Format_ARGB32);
+    QCOMPARE(image.pixel(0, 0), qRgba(0xff, 0x40, 0x20, 0x80));
+    QCOMPARE(image.pixel(1, 0), qRgba(0, 0, 0, 0xff));
+    QCOMPARE(image.pixel(0, 1), qRgba(0, 0, 0, 0));
+    QCOMPARE(image.pixel(1, 1), qRgba(0, 0, 0xff, 0xff));
+}
+
+void SystemTrayImageTest::testConversion_data()
+{
+    QTest::addColumn<Simd::Kernel>("kernel");
+    QTest::addColumn<int>("count");
+
+    // Every kernel the machine runs, with counts that leave remainders for each vector width
+    const QVector<Simd::Kernel> kernels = Simd::supportedKernels();
+    for (Simd::Kernel kernel : kernels) {
+        for (int count : {1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 22 * 22, 1024 + 3}) {
+            QTest::addRow("%s-%d", Simd::name(kernel), count) << kernel << count;
+        }
+    }
+}
+
+void SystemTrayImageTest::testConversion()
+{
+    QFETCH(Simd::Kernel, kernel);
+    QFETCH(int, count);
+
+    const QByteArray data = randomPixels(count);
+    const auto source = reinterpret_cast<const uchar *>(data.constData());
+
+    QVector<quint32> expected(count);
+    for (int i = 0; i < count; ++i) {
+        expected[i] = qFromBigEndian<quint32>(source + i * 4);
+    }
+
+    QVector<quint32> converted(count);
+    SystemTrayImage::argbFromBigEndian(source, converted.data(), count, kernel);
+    QCOMPARE(converted, expected);
+}
+
+void SystemTrayImageTest::testDecodeTwice()
+{
+    // Decoding used to swap the bytes in place, which broke every copy sharing the data
+    const QByteArray data = randomPixels(16 * 16);
+    const QByteArray original(data.constData(), data.size());
+    const KDbusImageStruct image = imageStruct(16, 16, data);
+    const KDbusImageStruct copy = image;
+
+    const QImage first = SystemTrayImage::toImage(image);
+    const QImage second = SystemTrayImage::toImage(image);
+    const QImage third = SystemTrayImage::toImage(copy);
+
+    QVERIFY(!first.isNull());
+    QCOMPARE(second, first);
+    QCOMPARE(third, first);
+    QCOMPARE(image.data, original);
+    QCOMPARE(copy.data, original);
+    QCOMPARE(data, original);
+}
+
+void SystemTrayImageTest::testInvalidImage_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("bytes");
+
+    QTest::addRow("empty") << 0 << 0 << 0;
+    QTest::addRow("no width") << 0 << 16 << 16 * 4;
+    QTest::addRow("negative height") << 16 << -1 << 16 * 4;
+    QTest::addRow("short data") << 16 << 16 << 16 * 16 * 4 - 1;
+}
+
+void SystemTrayImageTest::testInvalidImage()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, bytes);
+
+    QVERIFY(SystemTrayImage::toImage(imageStruct(width, height, QByteArray(bytes, '\xff'))).isNull());
+}
+
+void SystemTrayImageTest::testIcon()
+{
+    const KDbusImageVector vector = {
+        imageStruct(16, 16, randomPixels(16 * 16)),
+        imageStruct(0, 0, QByteArray()),
+        imageStruct(22, 22, randomPixels(22 * 22)),
+    };
+
+    const QIcon icon = SystemTrayImage::toIcon(vector);
+    QCOMPARE(icon.availableSizes(), QList<QSize>({QSize(16, 16), QSize(22, 22)}));
+}
+
+QTEST_MAIN(SystemTrayImageTest)
+
+#include "systemtrayimagetest.moc"
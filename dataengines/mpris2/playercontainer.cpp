@@ -17,9 +17,15 @@
 
 #include <QDBusConnection>
 #include <QDateTime>
+#include <QTimer>
 
 #include "debug.h"
 
+// How often the extrapolated position is compared with the one of the player
+static constexpr int s_positionCheckInterval = 30000; // ms
+// Drift below this is not worth telling the users of the position about
+static constexpr qint64 s_positionDriftTolerance = 250000; // us
+
 static QVariant::Type expPropType(const QString &propName)
 {
     if (propName == QLatin1String("Identity"))
@@ -100,6 +106,8 @@ PlayerContainer::PlayerContainer(const QString &busAddress, QObject *parent)
     , m_fetchesPending(0)
     , m_dbusAddress(busAddress)
     , m_currentRate(0.0)
+    , m_positionAnchor(0)
+    , m_positionCheckTimer(new QTimer(this))
 {
     Q_ASSERT(!busAddress.isEmpty());
     Q_ASSERT(busAddress.startsWith(QLatin1String("org.mpris.MediaPlayer2.")));
@@ -123,6 +131,15 @@ PlayerContainer::PlayerContainer(const QString &busAddress, QObject *parent)
 
     connect(m_playerIface, &OrgMprisMediaPlayer2PlayerInterface::Seeked, this, &PlayerContainer::seeked);
 
+    // The position is extrapolated locally while playing; the player is only asked
+    // now and then to catch up with drift, and only if someone looks at it
+    m_positionCheckTimer->setInterval(s_positionCheckInterval);
+    connect(m_positionCheckTimer, &QTimer::timeout, this, [this]() {
+        if (isUsed()) {
+            fetchPosition();
+        }
+    });
+
     refresh();
 }
 
@@ -209,6 +226,7 @@ void PlayerContainer::copyProperty(const QString &propName, const QVariant &_val
     }
     if (value.convert(expType)) {
         if (propName == QLatin1String("Position")) {
+            setPositionAnchor(value.toLongLong());
             setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
 
         } else if (propName == QLatin1String("Metadata")) {
@@ -216,6 +234,7 @@ void PlayerContainer::copyProperty(const QString &propName, const QVariant &_val
                 const QString oldTrackId = data().value(QStringLiteral("Metadata")).toMap().value(QStringLiteral("mpris:trackid")).toString();
                 const QString newTrackId = value.toMap().value(QStringLiteral("mpris:trackid")).toString();
                 if (oldTrackId != newTrackId) {
+                    setPositionAnchor(0);
                     setData(QStringLiteral("Position"), static_cast<qlonglong>(0));
                     setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
                 }
@@ -228,25 +247,26 @@ void PlayerContainer::copyProperty(const QString &propName, const QVariant &_val
             }
 
         } else if (propName == QLatin1String("Rate") && data().value(QStringLiteral("PlaybackStatus")).toString() == QLatin1String("Playing")) {
-            if (data().contains(QLatin1String("Position")))
-                recalculatePosition();
-            m_currentRate = value.toDouble();
+            setEffectiveRate(value.toDouble());
+            if (updType == UpdatedSignal) {
+                fetchPosition();
+            }
 
         } else if (propName == QLatin1String("PlaybackStatus")) {
-            if (data().contains(QLatin1String("Position")) && data().contains(QLatin1String("PlaybackStatus"))) {
-                updatePosition();
+            // update the effective rate; players that do not tell it play at normal speed
+            if (value.toString() == QLatin1String("Playing")) {
+                setEffectiveRate(data().value(QStringLiteral("Rate"), 1.0).toDouble());
+            } else {
+                setEffectiveRate(0.0);
             }
-
-            // update the effective rate
-            if (data().contains(QLatin1String("Rate"))) {
-                if (value.toString() == QLatin1String("Playing"))
-                    m_currentRate = data().value(QStringLiteral("Rate")).toDouble();
-                else
-                    m_currentRate = 0.0;
+            if (updType == UpdatedSignal && data().contains(QLatin1String("Position"))) {
+                fetchPosition();
             }
+
             if (value.toString() == QLatin1String("Stopped")) {
                 // assume the position has reset to 0, since this is really the
                 // only sensible value for a stopped track
+                setPositionAnchor(0);
                 setData(QStringLiteral("Position"), static_cast<qint64>(0));
                 setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
             }
@@ -332,6 +352,26 @@ void PlayerContainer::getPropsFinished(QDBusPendingCallWatcher *watcher)
 }
 
 void PlayerContainer::updatePosition()
+{
+    publishPosition();
+    checkForUpdate();
+}
+
+qint64 PlayerContainer::currentPosition() const
+{
+    if (!m_positionAnchorTime.isValid()) {
+        return m_positionAnchor;
+    }
+
+    qint64 position = m_positionAnchor + static_cast<qint64>(m_positionAnchorTime.nsecsElapsed() / 1000 * m_currentRate);
+    const qint64 length = data().value(QStringLiteral("Metadata")).toMap().value(QStringLiteral("mpris:length")).toLongLong();
+    if (length > 0) {
+        position = qMin(position, length);
+    }
+    return qMax(position, qint64(0));
+}
+
+void PlayerContainer::fetchPosition()
 {
     QDBusPendingCall async = m_propsIface->Get(OrgMprisMediaPlayer2PlayerInterface::staticInterfaceName(), QStringLiteral("Position"));
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(async, this);
@@ -349,9 +389,45 @@ void PlayerContainer::getPositionFinished(QDBusPendingCallWatcher *watcher)
         return;
     }
 
-    setData(QStringLiteral("Position"), propsReply.value().toLongLong());
+    const qint64 position = propsReply.value().toLongLong();
+    const qint64 drift = position - currentPosition();
+    setPositionAnchor(position);
+
+    if (qAbs(drift) > s_positionDriftTolerance) {
+        qCDebug(MPRIS2) << m_dbusAddress << "position drifted by" << drift << "us";
+        publishPosition();
+        checkForUpdate();
+    }
+}
+
+void PlayerContainer::setPositionAnchor(qint64 position)
+{
+    m_positionAnchor = position;
+    m_positionAnchorTime.start();
+}
+
+void PlayerContainer::setEffectiveRate(double rate)
+{
+    // Keep the position reached at the old rate as the starting point for the new one
+    if (data().contains(QLatin1String("Position"))) {
+        setPositionAnchor(currentPosition());
+        m_currentRate = rate;
+        publishPosition();
+    } else {
+        m_currentRate = rate;
+    }
+
+    if (qFuzzyIsNull(m_currentRate)) {
+        m_positionCheckTimer->stop();
+    } else if (!m_positionCheckTimer->isActive()) {
+        m_positionCheckTimer->start();
+    }
+}
+
+void PlayerContainer::publishPosition()
+{
+    setData(QStringLiteral("Position"), currentPosition());
     setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
-    checkForUpdate();
 }
 
 void PlayerContainer::propertiesChanged(const QString &interface, const QVariantMap &changedProperties, const QStringList &invalidatedProperties)
@@ -367,20 +443,7 @@ void PlayerContainer::propertiesChanged(const QString &interface, const QVariant
 
 void PlayerContainer::seeked(qlonglong position)
 {
-    setData(QStringLiteral("Position"), position);
-    setData(POS_UPD_STRING, QDateTime::currentDateTimeUtc());
+    setPositionAnchor(position);
+    publishPosition();
     checkForUpdate();
 }
-
-void PlayerContainer::recalculatePosition()
-{
-    Q_ASSERT(data().contains("Position"));
-
-    qint64 pos = data().value(QStringLiteral("Position")).toLongLong();
-    QDateTime lastUpdated = data().value(POS_UPD_STRING).toDateTime();
-    QDateTime now = QDateTime::currentDateTimeUtc();
-    qint64 diff = lastUpdated.msecsTo(now) * 1000;
-    qint64 newPos = pos + static_cast<qint64>(diff * m_currentRate);
-    setData(QStringLiteral("Position"), newPos);
-    setData(POS_UPD_STRING, now);
-}
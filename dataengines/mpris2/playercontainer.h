@@ -7,12 +7,14 @@
 #pragma once
 
 #include <Plasma/DataContainer>
+#include <QElapsedTimer>
 #include <QFlags>
 
 class OrgFreedesktopDBusPropertiesInterface;
 class OrgMprisMediaPlayer2Interface;
 class OrgMprisMediaPlayer2PlayerInterface;
 class QDBusPendingCallWatcher;
+class QTimer;
 
 class PlayerContainer : public Plasma::DataContainer
 {
@@ -65,7 +67,12 @@ public:
     };
 
     void refresh();
+    /**
+     * Publishes the current position without asking the player, extrapolated
+     * from the last position it reported and the playback rate.
+     */
     void updatePosition();
+    qint64 currentPosition() const;
 
 Q_SIGNALS:
     void initialFetchFinished(PlayerContainer *self);
@@ -81,7 +88,10 @@ private Q_SLOTS:
 private:
     void copyProperty(const QString &propName, const QVariant &value, QVariant::Type expType, UpdateType updType);
     void updateFromMap(const QVariantMap &map, UpdateType updType);
-    void recalculatePosition();
+    void fetchPosition();
+    void setPositionAnchor(qint64 position);
+    void setEffectiveRate(double rate);
+    void publishPosition();
 
     Caps m_caps;
     int m_fetchesPending;
@@ -90,6 +100,10 @@ private:
     OrgMprisMediaPlayer2Interface *m_rootIface;
     OrgMprisMediaPlayer2PlayerInterface *m_playerIface;
     double m_currentRate;
+    // The position last reported by the player, and since when
+    qint64 m_positionAnchor;
+    QElapsedTimer m_positionAnchorTime;
+    QTimer *m_positionCheckTimer;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(PlayerContainer::Caps)
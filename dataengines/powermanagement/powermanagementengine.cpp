@@ -23,14 +23,18 @@
 #include <klocalizedstring.h>
 
 #include <QDebug>
+#include <QElapsedTimer>
 
-#include <QDBusConnectionInterface>
 #include <QDBusError>
 #include <QDBusInterface>
 #include <QDBusMetaType>
 #include <QDBusPendingCallWatcher>
-#include <QDBusReply>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
 
+#include <functional>
+
+#include "debug.h"
 #include "powermanagementservice.h"
 #include <Plasma/DataContainer>
 
@@ -39,10 +43,56 @@ static const char SOLID_POWERMANAGEMENT_SERVICE[] = "org.kde.Solid.PowerManageme
 Q_DECLARE_METATYPE(QList<InhibitionInfo>)
 Q_DECLARE_METATYPE(InhibitionInfo)
 
+namespace
+{
+// Answers taking longer than this are what makes the applets stall on a busy bus
+constexpr qint64 s_slowCallThreshold = 500; // ms
+
+QDBusMessage powerDevilCall(const QString &path, const QString &interface, const QString &method)
+{
+    return QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE, path, interface, method);
+}
+
+/**
+ * Sends @p message without waiting for the answer, then passes the returned value
+ * to @p handler, or calls @p errorHandler when the call failed.
+ * How long each call took is logged.
+ */
+template<typename T, typename Handler>
+void asyncCall(QObject *context, const QDBusMessage &message, Handler handler, const std::function<void()> &errorHandler = {})
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    auto watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), context);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, context, [message, timer, handler, errorHandler](QDBusPendingCallWatcher *watcher) {
+        watcher->deleteLater();
+
+        const qint64 elapsed = timer.elapsed();
+        if (elapsed > s_slowCallThreshold) {
+            qCWarning(POWERMANAGEMENT) << message.interface() << message.member() << "took" << elapsed << "ms";
+        } else {
+            qCDebug(POWERMANAGEMENT) << message.interface() << message.member() << "took" << elapsed << "ms";
+        }
+
+        QDBusPendingReply<T> reply = *watcher;
+        if (reply.isError()) {
+            qCDebug(POWERMANAGEMENT) << message.member() << "failed:" << reply.error().message();
+            if (errorHandler) {
+                errorHandler();
+            }
+            return;
+        }
+        handler(reply.value());
+    });
+}
+}
+
 PowermanagementEngine::PowermanagementEngine(QObject *parent, const QVariantList &args)
     : Plasma::DataEngine(parent, args)
     , m_sources(basicSourceNames())
     , m_session(new SessionManagement(this))
+    , m_serviceWatcher(new QDBusServiceWatcher(this))
 {
     Q_UNUSED(args)
     qDBusRegisterMetaType<QList<InhibitionInfo>>();
@@ -61,123 +111,91 @@ void PowermanagementEngine::init()
     connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceAdded, this, &PowermanagementEngine::deviceAdded);
     connect(Solid::DeviceNotifier::instance(), &Solid::DeviceNotifier::deviceRemoved, this, &PowermanagementEngine::deviceRemoved);
 
-    if (QDBusConnection::sessionBus().interface()->isServiceRegistered(SOLID_POWERMANAGEMENT_SERVICE)) {
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl"),
-                                                   QStringLiteral("brightnessChanged"),
-                                                   this,
-                                                   SLOT(screenBrightnessChanged(int)))) {
-            qDebug() << "error connecting to Brightness changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl"),
-                                                   QStringLiteral("brightnessMaxChanged"),
-                                                   this,
-                                                   SLOT(maximumScreenBrightnessChanged(int)))) {
-            qDebug() << "error connecting to max brightness changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl"),
-                                                   QStringLiteral("keyboardBrightnessChanged"),
-                                                   this,
-                                                   SLOT(keyboardBrightnessChanged(int)))) {
-            qDebug() << "error connecting to Keyboard Brightness changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl"),
-                                                   QStringLiteral("keyboardBrightnessMaxChanged"),
-                                                   this,
-                                                   SLOT(maximumKeyboardBrightnessChanged(int)))) {
-            qDebug() << "error connecting to max keyboard Brightness changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/HandleButtonEvents"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.HandleButtonEvents"),
-                                                   QStringLiteral("triggersLidActionChanged"),
-                                                   this,
-                                                   SLOT(triggersLidActionChanged(bool)))) {
-            qDebug() << "error connecting to lid action trigger changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/PolicyAgent"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.PolicyAgent"),
-                                                   QStringLiteral("InhibitionsChanged"),
-                                                   this,
-                                                   SLOT(inhibitionsChanged(QList<InhibitionInfo>, QStringList)))) {
-            qDebug() << "error connecting to inhibition changes via dbus";
-        }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement"),
-                                                   SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("batteryRemainingTimeChanged"),
-                                                   this,
-                                                   SLOT(batteryRemainingTimeChanged(qulonglong)))) {
-            qDebug() << "error connecting to remaining time changes";
-        }
+    m_serviceWatcher->setConnection(QDBusConnection::sessionBus());
+    m_serviceWatcher->setWatchMode(QDBusServiceWatcher::WatchForOwnerChange);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceOwnerChanged, this, [this](const QString &service, const QString &, const QString &newOwner) {
+        setServiceOwner(service, newOwner);
+    });
 
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement"),
-                                                   SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("chargeStopThresholdChanged"),
-                                                   this,
-                                                   SLOT(chargeStopThresholdChanged(int)))) {
-            qDebug() << "error connecting to charge stop threshold changes via dbus";
-        }
+    const QString brightnessPath = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl");
+    const QString brightnessInterface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl");
+    const QString keyboardPath = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl");
+    const QString keyboardInterface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl");
+    const QString profilePath = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile");
+    const QString profileInterface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile");
+
+    // Subscribe whether PowerDevil is running yet or not, the signals arrive once it is.
+    // Only its own signals are listened to, nobody else on the bus can fake them.
+    subscribeToService(SOLID_POWERMANAGEMENT_SERVICE, {
+        {brightnessPath, brightnessInterface, QStringLiteral("brightnessChanged"), SLOT(screenBrightnessChanged(int))},
+        {brightnessPath, brightnessInterface, QStringLiteral("brightnessMaxChanged"), SLOT(maximumScreenBrightnessChanged(int))},
+        {keyboardPath, keyboardInterface, QStringLiteral("keyboardBrightnessChanged"), SLOT(keyboardBrightnessChanged(int))},
+        {keyboardPath, keyboardInterface, QStringLiteral("keyboardBrightnessMaxChanged"), SLOT(maximumKeyboardBrightnessChanged(int))},
+        {QStringLiteral("/org/kde/Solid/PowerManagement/Actions/HandleButtonEvents"),
+         QStringLiteral("org.kde.Solid.PowerManagement.Actions.HandleButtonEvents"),
+         QStringLiteral("triggersLidActionChanged"),
+         SLOT(triggersLidActionChanged(bool))},
+        {QStringLiteral("/org/kde/Solid/PowerManagement/PolicyAgent"),
+         QStringLiteral("org.kde.Solid.PowerManagement.PolicyAgent"),
+         QStringLiteral("InhibitionsChanged"),
+         SLOT(inhibitionsChanged(QList<InhibitionInfo>, QStringList))},
+        {QStringLiteral("/org/kde/Solid/PowerManagement"),
+         SOLID_POWERMANAGEMENT_SERVICE,
+         QStringLiteral("batteryRemainingTimeChanged"),
+         SLOT(batteryRemainingTimeChanged(qulonglong))},
+        {QStringLiteral("/org/kde/Solid/PowerManagement"),
+         SOLID_POWERMANAGEMENT_SERVICE,
+         QStringLiteral("chargeStopThresholdChanged"),
+         SLOT(chargeStopThresholdChanged(int))},
+        {profilePath, profileInterface, QStringLiteral("currentProfileChanged"), SLOT(updatePowerProfileCurrentProfile(QString))},
+        {profilePath, profileInterface, QStringLiteral("profileChoicesChanged"), SLOT(updatePowerProfileChoices(QStringList))},
+        {profilePath, profileInterface, QStringLiteral("performanceInhibitedReasonChanged"), SLOT(updatePowerProfilePerformanceInhibitedReason(QString))},
+        {profilePath, profileInterface, QStringLiteral("performanceDegradedReasonChanged"), SLOT(updatePowerProfilePerformanceDegradedReason(QString))},
+        {profilePath, profileInterface, QStringLiteral("profileHoldsChanged"), SLOT(updatePowerProfileHolds(QList<QVariantMap>))},
+    });
+}
 
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                   QStringLiteral("currentProfileChanged"),
-                                                   this,
-                                                   SLOT(updatePowerProfileCurrentProfile(QString)))) {
-            qDebug() << "error connecting to current profile changes via dbus";
-        }
+void PowermanagementEngine::subscribeToService(const QString &service, const QVector<Subscription> &subscriptions)
+{
+    if (m_subscriptions.contains(service)) {
+        return;
+    }
+    m_subscriptions.insert(service, subscriptions);
+    m_serviceWatcher->addWatchedService(service);
+
+    // A service which is not running yet fails here, the watcher reports it once it starts
+    QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.DBus"),
+                                                          QStringLiteral("/org/freedesktop/DBus"),
+                                                          QStringLiteral("org.freedesktop.DBus"),
+                                                          QStringLiteral("GetNameOwner"));
+    message << service;
+    asyncCall<QString>(this, message, [this, service](const QString &owner) {
+        setServiceOwner(service, owner);
+    });
+}
 
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                   QStringLiteral("profileChoicesChanged"),
-                                                   this,
-                                                   SLOT(updatePowerProfileChoices(QStringList)))) {
-            qDebug() << "error connecting to profile choices changes via dbus";
-        }
+void PowermanagementEngine::setServiceOwner(const QString &service, const QString &owner)
+{
+    const QString previousOwner = m_serviceOwners.value(service);
+    if (owner == previousOwner) {
+        return;
+    }
 
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                   QStringLiteral("performanceInhibitedReasonChanged"),
-                                                   this,
-                                                   SLOT(updatePowerProfilePerformanceInhibitedReason(QString)))) {
-            qDebug() << "error connecting to inhibition reason changes via dbus";
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    const QVector<Subscription> subscriptions = m_subscriptions.value(service);
+    for (const Subscription &subscription : subscriptions) {
+        if (!previousOwner.isEmpty()) {
+            bus.disconnect(previousOwner, subscription.path, subscription.interface, subscription.signal, this, subscription.slot);
         }
-
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                   QStringLiteral("performanceDegradedReasonChanged"),
-                                                   this,
-                                                   SLOT(updatePowerProfilePerformanceDegradedReason(QString)))) {
-            qDebug() << "error connecting to degradation reason changes via dbus";
+        if (!owner.isEmpty() && !bus.connect(owner, subscription.path, subscription.interface, subscription.signal, this, subscription.slot)) {
+            qCWarning(POWERMANAGEMENT) << "error connecting to" << subscription.interface << subscription.signal << "via dbus";
         }
+    }
 
-        if (!QDBusConnection::sessionBus().connect(SOLID_POWERMANAGEMENT_SERVICE,
-                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                   QStringLiteral("profileHoldsChanged"),
-                                                   this,
-                                                   SLOT(updatePowerProfileHolds(QList<QVariantMap>)))) {
-            qDebug() << "error connecting to profile hold changes via dbus";
-        }
+    if (owner.isEmpty()) {
+        m_serviceOwners.remove(service);
+    } else {
+        m_serviceOwners.insert(service, owner);
     }
 }
 
@@ -201,8 +219,8 @@ bool PowermanagementEngine::sourceRequestEvent(const QString &name)
         m_batterySources.clear();
 
         if (listBattery.isEmpty()) {
-            setData(QStringLiteral("Battery"), QStringLiteral("Has Battery"), false);
-            setData(QStringLiteral("Battery"), QStringLiteral("Has Cumulative"), false);
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Battery"), false);
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Cumulative"), false);
             return true;
         }
 
@@ -229,247 +247,119 @@ bool PowermanagementEngine::sourceRequestEvent(const QString &name)
             updateBatteryPresentState(battery->isPresent(), deviceBattery.udi());
             updateBatteryPowerSupplyState(battery->isPowerSupply(), deviceBattery.udi());
 
-            setData(source, QStringLiteral("Vendor"), deviceBattery.vendor());
-            setData(source, QStringLiteral("Product"), deviceBattery.product());
-            setData(source, QStringLiteral("Capacity"), battery->capacity());
-            setData(source, QStringLiteral("Type"), batteryTypeToString(battery));
+            setDataIfChanged(source, QStringLiteral("Vendor"), deviceBattery.vendor());
+            setDataIfChanged(source, QStringLiteral("Product"), deviceBattery.product());
+            setDataIfChanged(source, QStringLiteral("Capacity"), battery->capacity());
+            setDataIfChanged(source, QStringLiteral("Type"), batteryTypeToString(battery));
         }
 
         updateBatteryNames();
         updateOverallBattery();
 
-        setData(QStringLiteral("Battery"), QStringLiteral("Sources"), batterySources);
-        setData(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !batterySources.isEmpty());
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Sources"), batterySources);
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !batterySources.isEmpty());
+
+        const QString path = QStringLiteral("/org/kde/Solid/PowerManagement");
         if (!batterySources.isEmpty()) {
-            QDBusMessage msg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                              QStringLiteral("/org/kde/Solid/PowerManagement"),
-                                                              SOLID_POWERMANAGEMENT_SERVICE,
-                                                              QStringLiteral("batteryRemainingTime"));
-            QDBusPendingReply<qulonglong> reply = QDBusConnection::sessionBus().asyncCall(msg);
-            QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
-            QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-                QDBusPendingReply<qulonglong> reply = *watcher;
-                if (!reply.isError()) {
-                    batteryRemainingTimeChanged(reply.value());
-                }
-                watcher->deleteLater();
+            asyncCall<qulonglong>(this, powerDevilCall(path, SOLID_POWERMANAGEMENT_SERVICE, QStringLiteral("batteryRemainingTime")), [this](qulonglong time) {
+                batteryRemainingTimeChanged(time);
             });
         }
-
-        QDBusMessage msg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                          QStringLiteral("/org/kde/Solid/PowerManagement"),
-                                                          SOLID_POWERMANAGEMENT_SERVICE,
-                                                          QStringLiteral("chargeStopThreshold"));
-        QDBusPendingReply<int> reply = QDBusConnection::sessionBus().asyncCall(msg);
-        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
-        QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<int> reply = *watcher;
-            if (!reply.isError()) {
-                chargeStopThresholdChanged(reply.value());
-            }
-            watcher->deleteLater();
+        asyncCall<int>(this, powerDevilCall(path, SOLID_POWERMANAGEMENT_SERVICE, QStringLiteral("chargeStopThreshold")), [this](int threshold) {
+            chargeStopThresholdChanged(threshold);
         });
 
         m_sources = basicSourceNames() + batterySources;
     } else if (name == QLatin1String("AC Adapter")) {
-        QDBusConnection::sessionBus().connect(QStringLiteral("org.freedesktop.PowerManagement"),
-                                              QStringLiteral("/org/freedesktop/PowerManagement"),
-                                              QStringLiteral("org.freedesktop.PowerManagement"),
-                                              QStringLiteral("PowerSaveStatusChanged"),
-                                              this,
-                                              SLOT(updateAcPlugState(bool)));
-
-        QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.PowerManagement"),
-                                                          QStringLiteral("/org/freedesktop/PowerManagement"),
-                                                          QStringLiteral("org.freedesktop.PowerManagement"),
-                                                          QStringLiteral("GetPowerSaveStatus"));
-        QDBusReply<bool> reply = QDBusConnection::sessionBus().call(msg);
-        updateAcPlugState(reply.isValid() ? reply.value() : false);
+        const QString path = QStringLiteral("/org/freedesktop/PowerManagement");
+        const QString interface = QStringLiteral("org.freedesktop.PowerManagement");
+
+        subscribeToService(interface, {{path, interface, QStringLiteral("PowerSaveStatusChanged"), SLOT(updateAcPlugState(bool))}});
+
+        const QDBusMessage msg = QDBusMessage::createMethodCall(interface, path, interface, QStringLiteral("GetPowerSaveStatus"));
+        asyncCall<bool>(
+            this,
+            msg,
+            [this](bool onBattery) {
+                updateAcPlugState(onBattery);
+            },
+            [this]() {
+                updateAcPlugState(false);
+            });
     } else if (name == QLatin1String("Sleep States")) {
-        setData(QStringLiteral("Sleep States"), QStringLiteral("Standby"), m_session->canSuspend());
-        setData(QStringLiteral("Sleep States"), QStringLiteral("Suspend"), m_session->canSuspend());
-        setData(QStringLiteral("Sleep States"), QStringLiteral("Hibernate"), m_session->canHibernate());
-        setData(QStringLiteral("Sleep States"), QStringLiteral("HybridSuspend"), m_session->canHybridSuspend());
-        setData(QStringLiteral("Sleep States"), QStringLiteral("LockScreen"), m_session->canLock());
-        setData(QStringLiteral("Sleep States"), QStringLiteral("Logout"), m_session->canLogout());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("Standby"), m_session->canSuspend());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("Suspend"), m_session->canSuspend());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("Hibernate"), m_session->canHibernate());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("HybridSuspend"), m_session->canHybridSuspend());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("LockScreen"), m_session->canLock());
+        setDataIfChanged(QStringLiteral("Sleep States"), QStringLiteral("Logout"), m_session->canLogout());
     } else if (name == QLatin1String("PowerDevil")) {
-        QDBusMessage screenMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl"),
-                                                                QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl"),
-                                                                QStringLiteral("brightness"));
-        QDBusPendingReply<int> screenReply = QDBusConnection::sessionBus().asyncCall(screenMsg);
-        QDBusPendingCallWatcher *screenWatcher = new QDBusPendingCallWatcher(screenReply, this);
-        QObject::connect(screenWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<int> reply = *watcher;
-            if (!reply.isError()) {
-                screenBrightnessChanged(reply.value());
-            }
-            watcher->deleteLater();
+        // PowerDevil has no properties to fetch in one go, so all the values are asked for
+        // at once and the answers are applied as they come in
+        const QString brightnessPath = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl");
+        const QString brightnessInterface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl");
+        const QString keyboardPath = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl");
+        const QString keyboardInterface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl");
+
+        asyncCall<int>(this, powerDevilCall(brightnessPath, brightnessInterface, QStringLiteral("brightness")), [this](int brightness) {
+            screenBrightnessChanged(brightness);
         });
-
-        QDBusMessage maxScreenMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                   QStringLiteral("/org/kde/Solid/PowerManagement/Actions/BrightnessControl"),
-                                                                   QStringLiteral("org.kde.Solid.PowerManagement.Actions.BrightnessControl"),
-                                                                   QStringLiteral("brightnessMax"));
-        QDBusPendingReply<int> maxScreenReply = QDBusConnection::sessionBus().asyncCall(maxScreenMsg);
-        QDBusPendingCallWatcher *maxScreenWatcher = new QDBusPendingCallWatcher(maxScreenReply, this);
-        QObject::connect(maxScreenWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<int> reply = *watcher;
-            if (!reply.isError()) {
-                maximumScreenBrightnessChanged(reply.value());
-            }
-            watcher->deleteLater();
-        });
-
-        QDBusMessage keyboardMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                  QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl"),
-                                                                  QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl"),
-                                                                  QStringLiteral("keyboardBrightness"));
-        QDBusPendingReply<int> keyboardReply = QDBusConnection::sessionBus().asyncCall(keyboardMsg);
-        QDBusPendingCallWatcher *keyboardWatcher = new QDBusPendingCallWatcher(keyboardReply, this);
-        QObject::connect(keyboardWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<int> reply = *watcher;
-            if (!reply.isError()) {
-                keyboardBrightnessChanged(reply.value());
-            }
-            watcher->deleteLater();
+        asyncCall<int>(this, powerDevilCall(brightnessPath, brightnessInterface, QStringLiteral("brightnessMax")), [this](int maximumBrightness) {
+            maximumScreenBrightnessChanged(maximumBrightness);
         });
-
-        QDBusMessage maxKeyboardMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                     QStringLiteral("/org/kde/Solid/PowerManagement/Actions/KeyboardBrightnessControl"),
-                                                                     QStringLiteral("org.kde.Solid.PowerManagement.Actions.KeyboardBrightnessControl"),
-                                                                     QStringLiteral("keyboardBrightnessMax"));
-        QDBusPendingReply<int> maxKeyboardReply = QDBusConnection::sessionBus().asyncCall(maxKeyboardMsg);
-        QDBusPendingCallWatcher *maxKeyboardWatcher = new QDBusPendingCallWatcher(maxKeyboardReply, this);
-        QObject::connect(maxKeyboardWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<int> reply = *watcher;
-            if (!reply.isError()) {
-                maximumKeyboardBrightnessChanged(reply.value());
-            }
-            watcher->deleteLater();
+        asyncCall<int>(this, powerDevilCall(keyboardPath, keyboardInterface, QStringLiteral("keyboardBrightness")), [this](int brightness) {
+            keyboardBrightnessChanged(brightness);
         });
-
-        QDBusMessage lidIsPresentMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                      QStringLiteral("/org/kde/Solid/PowerManagement"),
-                                                                      SOLID_POWERMANAGEMENT_SERVICE,
-                                                                      QStringLiteral("isLidPresent"));
-        QDBusPendingReply<bool> lidIsPresentReply = QDBusConnection::sessionBus().asyncCall(lidIsPresentMsg);
-        QDBusPendingCallWatcher *lidIsPresentWatcher = new QDBusPendingCallWatcher(lidIsPresentReply, this);
-        QObject::connect(lidIsPresentWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<bool> reply = *watcher;
-            if (!reply.isError()) {
-                setData(QStringLiteral("PowerDevil"), QStringLiteral("Is Lid Present"), reply.value());
-            }
-            watcher->deleteLater();
+        asyncCall<int>(this, powerDevilCall(keyboardPath, keyboardInterface, QStringLiteral("keyboardBrightnessMax")), [this](int maximumBrightness) {
+            maximumKeyboardBrightnessChanged(maximumBrightness);
         });
-
-        QDBusMessage triggersLidActionMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                           QStringLiteral("/org/kde/Solid/PowerManagement/Actions/HandleButtonEvents"),
-                                                                           QStringLiteral("org.kde.Solid.PowerManagement.Actions.HandleButtonEvents"),
-                                                                           QStringLiteral("triggersLidAction"));
-        QDBusPendingReply<bool> triggersLidActionReply = QDBusConnection::sessionBus().asyncCall(triggersLidActionMsg);
-        QDBusPendingCallWatcher *triggersLidActionWatcher = new QDBusPendingCallWatcher(triggersLidActionReply, this);
-        QObject::connect(triggersLidActionWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<bool> reply = *watcher;
-            if (!reply.isError()) {
-                triggersLidActionChanged(reply.value());
-            }
-            watcher->deleteLater();
-        });
-
+        asyncCall<bool>(this,
+                        powerDevilCall(QStringLiteral("/org/kde/Solid/PowerManagement"), SOLID_POWERMANAGEMENT_SERVICE, QStringLiteral("isLidPresent")),
+                        [this](bool present) {
+                            setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Is Lid Present"), present);
+                        });
+        asyncCall<bool>(this,
+                        powerDevilCall(QStringLiteral("/org/kde/Solid/PowerManagement/Actions/HandleButtonEvents"),
+                                       QStringLiteral("org.kde.Solid.PowerManagement.Actions.HandleButtonEvents"),
+                                       QStringLiteral("triggersLidAction")),
+                        [this](bool triggers) {
+                            triggersLidActionChanged(triggers);
+                        });
     } else if (name == QLatin1String("Inhibitions")) {
-        QDBusMessage inhibitionsMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                                     QStringLiteral("/org/kde/Solid/PowerManagement/PolicyAgent"),
-                                                                     QStringLiteral("org.kde.Solid.PowerManagement.PolicyAgent"),
-                                                                     QStringLiteral("ListInhibitions"));
-        QDBusPendingReply<QList<InhibitionInfo>> inhibitionsReply = QDBusConnection::sessionBus().asyncCall(inhibitionsMsg);
-        QDBusPendingCallWatcher *inhibitionsWatcher = new QDBusPendingCallWatcher(inhibitionsReply, this);
-        QObject::connect(inhibitionsWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            QDBusPendingReply<QList<InhibitionInfo>> reply = *watcher;
-            watcher->deleteLater();
-
-            if (!reply.isError()) {
-                removeAllData(QStringLiteral("Inhibitions"));
-
-                inhibitionsChanged(reply.value(), QStringList());
-            }
-        });
+        asyncCall<QList<InhibitionInfo>>(this,
+                                         powerDevilCall(QStringLiteral("/org/kde/Solid/PowerManagement/PolicyAgent"),
+                                                        QStringLiteral("org.kde.Solid.PowerManagement.PolicyAgent"),
+                                                        QStringLiteral("ListInhibitions")),
+                                         [this](const QList<InhibitionInfo> &inhibitions) {
+                                             removeAllData(QStringLiteral("Inhibitions"));
+
+                                             inhibitionsChanged(inhibitions, QStringList());
+                                         });
 
         // any info concerning lock screen/screensaver goes here
     } else if (name == QLatin1String("UserActivity")) {
-        setData(QStringLiteral("UserActivity"), QStringLiteral("IdleTime"), KIdleTime::instance()->idleTime());
+        setDataIfChanged(QStringLiteral("UserActivity"), QStringLiteral("IdleTime"), KIdleTime::instance()->idleTime());
     } else if (name == QLatin1String("Power Profiles")) {
-        auto profileMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                         QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                         QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                         QStringLiteral("currentProfile"));
-        auto profileWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(profileMsg));
-        connect(profileWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            watcher->deleteLater();
-            QDBusPendingReply<QString> reply = *watcher;
-            if (reply.isError()) {
-                return;
-            }
-            updatePowerProfileCurrentProfile(reply.value());
-        });
+        const QString path = QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile");
+        const QString interface = QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile");
 
-        auto choicesMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                         QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                         QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                         QStringLiteral("profileChoices"));
-        auto choicesWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(choicesMsg));
-        connect(choicesWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            watcher->deleteLater();
-            QDBusPendingReply<QStringList> reply = *watcher;
-            if (reply.isError()) {
-                return;
-            }
-            updatePowerProfileChoices(reply.value());
+        asyncCall<QString>(this, powerDevilCall(path, interface, QStringLiteral("currentProfile")), [this](const QString &profile) {
+            updatePowerProfileCurrentProfile(profile);
         });
-
-        auto inhibitedMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                           QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                           QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                           QStringLiteral("performanceInhibitedReason"));
-        auto inhibitedWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(inhibitedMsg));
-        connect(inhibitedWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            watcher->deleteLater();
-            QDBusPendingReply<QString> reply = *watcher;
-            if (reply.isError()) {
-                return;
-            }
-            updatePowerProfilePerformanceInhibitedReason(reply.value());
+        asyncCall<QStringList>(this, powerDevilCall(path, interface, QStringLiteral("profileChoices")), [this](const QStringList &choices) {
+            updatePowerProfileChoices(choices);
         });
-
-        auto degradedMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                          QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                          QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                          QStringLiteral("performanceDegradedReason"));
-        auto degradedWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(degradedMsg));
-        connect(degradedWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            watcher->deleteLater();
-            QDBusPendingReply<QString> reply = *watcher;
-            if (reply.isError()) {
-                return;
-            };
-            updatePowerProfilePerformanceDegradedReason(reply.value());
+        asyncCall<QString>(this, powerDevilCall(path, interface, QStringLiteral("performanceInhibitedReason")), [this](const QString &reason) {
+            updatePowerProfilePerformanceInhibitedReason(reason);
         });
-
-        auto holdsMsg = QDBusMessage::createMethodCall(SOLID_POWERMANAGEMENT_SERVICE,
-                                                       QStringLiteral("/org/kde/Solid/PowerManagement/Actions/PowerProfile"),
-                                                       QStringLiteral("org.kde.Solid.PowerManagement.Actions.PowerProfile"),
-                                                       QStringLiteral("profileHolds"));
-        auto holdsWatcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(holdsMsg));
-        connect(holdsWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
-            watcher->deleteLater();
-            QDBusPendingReply<QList<QVariantMap>> reply = *watcher;
-            if (reply.isError()) {
-                return;
-            };
-            updatePowerProfileHolds(reply.value());
+        asyncCall<QString>(this, powerDevilCall(path, interface, QStringLiteral("performanceDegradedReason")), [this](const QString &reason) {
+            updatePowerProfilePerformanceDegradedReason(reason);
+        });
+        asyncCall<QList<QVariantMap>>(this, powerDevilCall(path, interface, QStringLiteral("profileHolds")), [this](const QList<QVariantMap> &holds) {
+            updatePowerProfileHolds(holds);
         });
     } else {
-        qDebug() << "Data for" << name << "not found";
+        qCDebug(POWERMANAGEMENT) << "Data for" << name << "not found";
         return false;
     }
     return true;
@@ -504,7 +394,7 @@ QString PowermanagementEngine::batteryTypeToString(const Solid::Battery *battery
 bool PowermanagementEngine::updateSourceEvent(const QString &source)
 {
     if (source == QLatin1String("UserActivity")) {
-        setData(QStringLiteral("UserActivity"), QStringLiteral("IdleTime"), KIdleTime::instance()->idleTime());
+        setDataIfChanged(QStringLiteral("UserActivity"), QStringLiteral("IdleTime"), KIdleTime::instance()->idleTime());
         return true;
     }
     return Plasma::DataEngine::updateSourceEvent(source);
@@ -519,6 +409,20 @@ Plasma::Service *PowermanagementEngine::serviceForSource(const QString &source)
     return nullptr;
 }
 
+void PowermanagementEngine::setDataIfChanged(const QString &source, const QString &key, const QVariant &value)
+{
+    // setData() marks the source as updated even for the same value, which has every
+    // applet reevaluate its bindings on each repeated D-Bus signal
+    if (const Plasma::DataContainer *container = containerForSource(source)) {
+        const Data data = container->data();
+        const auto it = data.constFind(key);
+        if (it != data.constEnd() && it->userType() == value.userType() && *it == value) {
+            return;
+        }
+    }
+    setData(source, key, value);
+}
+
 QString PowermanagementEngine::batteryStateToString(int newState) const
 {
     QString state(QStringLiteral("Unknown"));
@@ -538,33 +442,33 @@ QString PowermanagementEngine::batteryStateToString(int newState) const
 void PowermanagementEngine::updateBatteryChargeState(int newState, const QString &udi)
 {
     const QString source = m_batterySources[udi];
-    setData(source, QStringLiteral("State"), batteryStateToString(newState));
+    setDataIfChanged(source, QStringLiteral("State"), batteryStateToString(newState));
     updateOverallBattery();
 }
 
 void PowermanagementEngine::updateBatteryPresentState(bool newState, const QString &udi)
 {
     const QString source = m_batterySources[udi];
-    setData(source, QStringLiteral("Plugged in"), newState); // FIXME This needs to be renamed and Battery Monitor adjusted
+    setDataIfChanged(source, QStringLiteral("Plugged in"), newState); // FIXME This needs to be renamed and Battery Monitor adjusted
 }
 
 void PowermanagementEngine::updateBatteryChargePercent(int newValue, const QString &udi)
 {
     const QString source = m_batterySources[udi];
-    setData(source, QStringLiteral("Percent"), newValue);
+    setDataIfChanged(source, QStringLiteral("Percent"), newValue);
     updateOverallBattery();
 }
 
 void PowermanagementEngine::updateBatteryEnergy(double newValue, const QString &udi)
 {
     const QString source = m_batterySources[udi];
-    setData(source, QStringLiteral("Energy"), newValue);
+    setDataIfChanged(source, QStringLiteral("Energy"), newValue);
 }
 
 void PowermanagementEngine::updateBatteryPowerSupplyState(bool newState, const QString &udi)
 {
     const QString source = m_batterySources[udi];
-    setData(source, QStringLiteral("Is Power Supply"), newState);
+    setDataIfChanged(source, QStringLiteral("Is Power Supply"), newState);
 }
 
 void PowermanagementEngine::updateBatteryNames()
@@ -582,16 +486,16 @@ void PowermanagementEngine::updateBatteryNames()
 
             if (!batteryProduct.isEmpty() && batteryProduct != QLatin1String("Unknown Battery") && showBatteryName) {
                 if (!batteryVendor.isEmpty()) {
-                    setData(source, QStringLiteral("Pretty Name"), QString(batteryVendor + ' ' + batteryProduct));
+                    setDataIfChanged(source, QStringLiteral("Pretty Name"), QString(batteryVendor + ' ' + batteryProduct));
                 } else {
-                    setData(source, QStringLiteral("Pretty Name"), batteryProduct);
+                    setDataIfChanged(source, QStringLiteral("Pretty Name"), batteryProduct);
                 }
             } else {
                 ++unnamedBatteries;
                 if (unnamedBatteries > 1) {
-                    setData(source, QStringLiteral("Pretty Name"), i18nc("Placeholder is the battery number", "Battery %1", unnamedBatteries));
+                    setDataIfChanged(source, QStringLiteral("Pretty Name"), i18nc("Placeholder is the battery number", "Battery %1", unnamedBatteries));
                 } else {
-                    setData(source, QStringLiteral("Pretty Name"), i18n("Battery"));
+                    setDataIfChanged(source, QStringLiteral("Pretty Name"), i18n("Battery"));
                 }
             }
         }
@@ -631,55 +535,55 @@ void PowermanagementEngine::updateOverallBattery()
         // Energy is sometimes way off causing us to show rubbish; this is a UPower issue
         // but anyway having just one battery and the tooltip showing strange readings
         // compared to the popup doesn't look polished.
-        setData(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(totalPercentage));
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(totalPercentage));
     } else if (totalEnergy > 0) {
-        setData(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(energy / totalEnergy * 100));
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(energy / totalEnergy * 100));
     } else if (count > 0) { // UPS don't have energy, see Bug 348588
-        setData(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(totalPercentage / static_cast<qreal>(count)));
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Percent"), qRound(totalPercentage / static_cast<qreal>(count)));
     } else {
-        setData(QStringLiteral("Battery"), QStringLiteral("Percent"), int(0));
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Percent"), int(0));
     }
 
     if (hasCumulative) {
         if (allFullyCharged) {
-            setData(QStringLiteral("Battery"), QStringLiteral("State"), "FullyCharged");
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("State"), "FullyCharged");
         } else if (charging) {
-            setData(QStringLiteral("Battery"), QStringLiteral("State"), "Charging");
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("State"), "Charging");
         } else if (noCharge) {
-            setData(QStringLiteral("Battery"), QStringLiteral("State"), "NoCharge");
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("State"), "NoCharge");
         } else {
-            setData(QStringLiteral("Battery"), QStringLiteral("State"), "Discharging");
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("State"), "Discharging");
         }
     } else {
-        setData(QStringLiteral("Battery"), QStringLiteral("State"), "Unknown");
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("State"), "Unknown");
     }
 
-    setData(QStringLiteral("Battery"), QStringLiteral("Has Cumulative"), hasCumulative);
+    setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Cumulative"), hasCumulative);
 }
 
 void PowermanagementEngine::updateAcPlugState(bool onBattery)
 {
-    setData(QStringLiteral("AC Adapter"), QStringLiteral("Plugged in"), !onBattery);
+    setDataIfChanged(QStringLiteral("AC Adapter"), QStringLiteral("Plugged in"), !onBattery);
 }
 
 void PowermanagementEngine::updatePowerProfileCurrentProfile(const QString &activeProfile)
 {
-    setData(QStringLiteral("Power Profiles"), QStringLiteral("Current Profile"), activeProfile);
+    setDataIfChanged(QStringLiteral("Power Profiles"), QStringLiteral("Current Profile"), activeProfile);
 }
 
 void PowermanagementEngine::updatePowerProfileChoices(const QStringList &choices)
 {
-    setData(QStringLiteral("Power Profiles"), QStringLiteral("Profiles"), choices);
+    setDataIfChanged(QStringLiteral("Power Profiles"), QStringLiteral("Profiles"), choices);
 }
 
 void PowermanagementEngine::updatePowerProfilePerformanceInhibitedReason(const QString &reason)
 {
-    setData(QStringLiteral("Power Profiles"), QStringLiteral("Performance Inhibited Reason"), reason);
+    setDataIfChanged(QStringLiteral("Power Profiles"), QStringLiteral("Performance Inhibited Reason"), reason);
 }
 
 void PowermanagementEngine::updatePowerProfilePerformanceDegradedReason(const QString &reason)
 {
-    setData(QStringLiteral("Power Profiles"), QStringLiteral("Performance Degraded Reason"), reason);
+    setDataIfChanged(QStringLiteral("Power Profiles"), QStringLiteral("Performance Degraded Reason"), reason);
 }
 
 void PowermanagementEngine::updatePowerProfileHolds(const QList<QVariantMap> &holds)
@@ -696,7 +600,7 @@ void PowermanagementEngine::updatePowerProfileHolds(const QList<QVariantMap> &ho
             {QStringLiteral("Profile"), hold[QStringLiteral("Profile")]},
         };
     });
-    setData(QStringLiteral("Power Profiles"), QStringLiteral("Profile Holds"), QVariant::fromValue(out));
+    setDataIfChanged(QStringLiteral("Power Profiles"), QStringLiteral("Profile Holds"), QVariant::fromValue(out));
 }
 
 void PowermanagementEngine::deviceRemoved(const QString &udi)
@@ -713,8 +617,8 @@ void PowermanagementEngine::deviceRemoved(const QString &udi)
 
         QStringList sourceNames(m_batterySources.values());
         sourceNames.removeAll(source);
-        setData(QStringLiteral("Battery"), QStringLiteral("Sources"), sourceNames);
-        setData(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !sourceNames.isEmpty());
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Sources"), sourceNames);
+        setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !sourceNames.isEmpty());
 
         updateOverallBattery();
     }
@@ -750,13 +654,13 @@ void PowermanagementEngine::deviceAdded(const QString &udi)
             updateBatteryPresentState(battery->isPresent(), device.udi());
             updateBatteryPowerSupplyState(battery->isPowerSupply(), device.udi());
 
-            setData(source, QStringLiteral("Vendor"), device.vendor());
-            setData(source, QStringLiteral("Product"), device.product());
-            setData(source, QStringLiteral("Capacity"), battery->capacity());
-            setData(source, QStringLiteral("Type"), batteryTypeToString(battery));
+            setDataIfChanged(source, QStringLiteral("Vendor"), device.vendor());
+            setDataIfChanged(source, QStringLiteral("Product"), device.product());
+            setDataIfChanged(source, QStringLiteral("Capacity"), battery->capacity());
+            setDataIfChanged(source, QStringLiteral("Type"), batteryTypeToString(battery));
 
-            setData(QStringLiteral("Battery"), QStringLiteral("Sources"), sourceNames);
-            setData(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !sourceNames.isEmpty());
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Sources"), sourceNames);
+            setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Has Battery"), !sourceNames.isEmpty());
 
             updateBatteryNames();
             updateOverallBattery();
@@ -767,34 +671,34 @@ void PowermanagementEngine::deviceAdded(const QString &udi)
 void PowermanagementEngine::batteryRemainingTimeChanged(qulonglong time)
 {
     // qDebug() << "Remaining time 2:" << time;
-    setData(QStringLiteral("Battery"), QStringLiteral("Remaining msec"), time);
+    setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Remaining msec"), time);
 }
 
 void PowermanagementEngine::screenBrightnessChanged(int brightness)
 {
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Screen Brightness"), brightness);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Screen Brightness"), brightness);
 }
 
 void PowermanagementEngine::maximumScreenBrightnessChanged(int maximumBrightness)
 {
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Maximum Screen Brightness"), maximumBrightness);
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Screen Brightness Available"), maximumBrightness > 0);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Maximum Screen Brightness"), maximumBrightness);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Screen Brightness Available"), maximumBrightness > 0);
 }
 
 void PowermanagementEngine::keyboardBrightnessChanged(int brightness)
 {
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Keyboard Brightness"), brightness);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Keyboard Brightness"), brightness);
 }
 
 void PowermanagementEngine::maximumKeyboardBrightnessChanged(int maximumBrightness)
 {
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Maximum Keyboard Brightness"), maximumBrightness);
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Keyboard Brightness Available"), maximumBrightness > 0);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Maximum Keyboard Brightness"), maximumBrightness);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Keyboard Brightness Available"), maximumBrightness > 0);
 }
 
 void PowermanagementEngine::triggersLidActionChanged(bool triggers)
 {
-    setData(QStringLiteral("PowerDevil"), QStringLiteral("Triggers Lid Action"), triggers);
+    setDataIfChanged(QStringLiteral("PowerDevil"), QStringLiteral("Triggers Lid Action"), triggers);
 }
 
 void PowermanagementEngine::inhibitionsChanged(const QList<InhibitionInfo> &added, const QStringList &removed)
@@ -811,7 +715,7 @@ void PowermanagementEngine::inhibitionsChanged(const QList<InhibitionInfo> &adde
 
         populateApplicationData(name, &prettyName, &icon);
 
-        setData(QStringLiteral("Inhibitions"),
+        setDataIfChanged(QStringLiteral("Inhibitions"),
                 name,
                 QVariantMap{{QStringLiteral("Name"), prettyName}, {QStringLiteral("Icon"), icon}, {QStringLiteral("Reason"), reason}});
     }
@@ -839,7 +743,7 @@ void PowermanagementEngine::populateApplicationData(const QString &name, QString
 
 void PowermanagementEngine::chargeStopThresholdChanged(int threshold)
 {
-    setData(QStringLiteral("Battery"), QStringLiteral("Charge Stop Threshold"), threshold);
+    setDataIfChanged(QStringLiteral("Battery"), QStringLiteral("Charge Stop Threshold"), threshold);
 }
 
 K_PLUGIN_CLASS_WITH_JSON(PowermanagementEngine, "plasma-dataengine-powermanagement.json")
@@ -15,7 +15,9 @@
 #include <QDBusConnection>
 #include <QHash>
 #include <QPair>
+#include <QVector>
 
+class QDBusServiceWatcher;
 class SessionManagement;
 
 using InhibitionInfo = QPair<QString, QString>;
@@ -71,6 +73,24 @@ private:
     QString batteryTypeToString(const Solid::Battery *battery) const;
     QStringList basicSourceNames() const;
     QString batteryStateToString(int newState) const;
+    // Like setData(), but leaves the source alone when the value did not change
+    void setDataIfChanged(const QString &source, const QString &key, const QVariant &value);
+
+    struct Subscription {
+        QString path;
+        QString interface;
+        QString signal;
+        const char *slot;
+    };
+    /**
+     * Connects @p subscriptions to the signals of whoever owns @p service, now and later.
+     *
+     * Naming the well-known service in QDBusConnection::connect() would make QtDBus look up
+     * its owner with a blocking call, so the owner is followed asynchronously instead and
+     * the signals are subscribed on its unique name.
+     */
+    void subscribeToService(const QString &service, const QVector<Subscription> &subscriptions);
+    void setServiceOwner(const QString &service, const QString &owner);
 
     QStringList m_sources;
 
@@ -78,4 +98,8 @@ private:
     QHash<QString, QPair<QString, QString>> m_applicationInfo; // <appname, <pretty name, icon>>
 
     SessionManagement *m_session;
+
+    QDBusServiceWatcher *m_serviceWatcher;
+    QHash<QString, QVector<Subscription>> m_subscriptions; // <service, subscriptions>
+    QHash<QString, QString> m_serviceOwners; // <service, unique name>
 };
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <sys/statvfs.h>
+
+#include "../freespacemonitor.h"
+
+class FreeSpaceMonitorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testBatch();
+    void testMissingPath();
+    void testFailingMount();
+    void testRemove();
+};
+
+void FreeSpaceMonitorTest::testBatch()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    struct statvfs info;
+    QCOMPARE(statvfs(QFile::encodeName(dir.path()).constData(), &info), 0);
+
+    FreeSpaceMonitor monitor;
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::freeSpaceChanged);
+
+    // both are polled with the same batch, each gets its values
+    monitor.update(QStringLiteral("first"), dir.path(), false);
+    monitor.update(QStringLiteral("second"), QStringLiteral("/"), false);
+    // already queued
+    monitor.update(QStringLiteral("first"), dir.path(), false);
+    QTRY_COMPARE(spy.count(), 2);
+
+    QStringList udis;
+    for (const QList<QVariant> &arguments : spy) {
+        udis << arguments.at(0).toString();
+        if (arguments.at(0).toString() == QLatin1String("first")) {
+            QCOMPARE(arguments.at(1).toULongLong(), quint64(info.f_blocks) * info.f_frsize);
+        }
+    }
+    udis.sort();
+    QCOMPARE(udis, QStringList({QStringLiteral("first"), QStringLiteral("second")}));
+}
+
+void FreeSpaceMonitorTest::testMissingPath()
+{
+    FreeSpaceMonitor monitor;
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::freeSpaceChanged);
+
+    monitor.update(QStringLiteral("gone"), QStringLiteral("/nonexistent/mount/point"), true);
+    QVERIFY(!spy.wait(500));
+}
+
+void FreeSpaceMonitorTest::testFailingMount()
+{
+    FreeSpaceMonitor monitor;
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::freeSpaceChanged);
+
+    // Polled in the same pass, the one that fails does not keep the other one from being reported
+    monitor.update(QStringLiteral("gone"), QStringLiteral("/nonexistent/mount/point"), false);
+    monitor.update(QStringLiteral("root"), QStringLiteral("/"), false);
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("root"));
+
+    // Both answered, the next update polls the working one again
+    spy.clear();
+    monitor.remove(QStringLiteral("root"));
+    monitor.update(QStringLiteral("root"), QStringLiteral("/"), false);
+    QTRY_COMPARE(spy.count(), 1);
+}
+
+void FreeSpaceMonitorTest::testRemove()
+{
+    FreeSpaceMonitor monitor;
+    QSignalSpy spy(&monitor, &FreeSpaceMonitor::freeSpaceChanged);
+
+    monitor.update(QStringLiteral("removed"), QStringLiteral("/"), false);
+    monitor.remove(QStringLiteral("removed"));
+    QVERIFY(!spy.wait(500));
+}
+
+QTEST_GUILESS_MAIN(FreeSpaceMonitorTest)
+
+#include "freespacemonitortest.moc"
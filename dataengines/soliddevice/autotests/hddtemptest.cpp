@@ -0,0 +1,139 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtTest>
+
+#include "../hddtemp.h"
+
+// Answers like the hddtemp daemon, in two parts to exercise the incremental parsing
+class FakeHddTempServer : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    FakeHddTempServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                ++connectionCount;
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                if (silent) {
+                    continue;
+                }
+                const int split = reply.size() / 2;
+                socket->write(reply.left(split));
+                socket->flush();
+                QTimer::singleShot(50, socket, [this, socket, split]() {
+                    socket->write(reply.mid(split));
+                    socket->disconnectFromHost();
+                });
+            }
+        });
+    }
+
+    QByteArray reply = QByteArrayLiteral("|/dev/sda|WDC WD10EZEX|38|C||/dev/sdb|Samsung SSD 860|31|C|");
+    bool silent = false;
+    int connectionCount = 0;
+};
+
+class HddTempTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testQuery();
+    void testUnchangedData();
+    void testNoDaemon();
+    void testSilentDaemon();
+};
+
+void HddTempTest::testQuery()
+{
+    FakeHddTempServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    HddTemp hddTemp(QStringLiteral("127.0.0.1"), server.serverPort());
+    QSignalSpy spy(&hddTemp, &HddTemp::dataChanged);
+    QVERIFY(spy.wait());
+
+    QCOMPARE(hddTemp.sources(), QStringList({QStringLiteral("/dev/sda"), QStringLiteral("/dev/sdb")}));
+    QCOMPARE(hddTemp.data(QStringLiteral("/dev/sda"), HddTemp::Temperature).toString(), QStringLiteral("38"));
+    QCOMPARE(hddTemp.data(QStringLiteral("/dev/sda"), HddTemp::Unit).toString(), QStringLiteral("C"));
+    QCOMPARE(hddTemp.data(QStringLiteral("/dev/sdb"), HddTemp::Temperature).toString(), QStringLiteral("31"));
+
+    // the values change with the next query
+    server.reply = QByteArrayLiteral("|/dev/sda|WDC WD10EZEX|41|C|");
+    hddTemp.update();
+    QVERIFY(spy.wait());
+    QCOMPARE(hddTemp.sources(), QStringList({QStringLiteral("/dev/sda")}));
+    QCOMPARE(hddTemp.data(QStringLiteral("/dev/sda"), HddTemp::Temperature).toString(), QStringLiteral("41"));
+}
+
+void HddTempTest::testUnchangedData()
+{
+    FakeHddTempServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    HddTemp hddTemp(QStringLiteral("127.0.0.1"), server.serverPort());
+    QSignalSpy spy(&hddTemp, &HddTemp::dataChanged);
+    QVERIFY(spy.wait());
+
+    // running queries are not duplicated
+    hddTemp.update();
+    hddTemp.update();
+    QTRY_COMPARE(server.connectionCount, 2);
+    QVERIFY(!spy.wait(500));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(server.connectionCount, 2);
+}
+
+void HddTempTest::testNoDaemon()
+{
+    // a port nobody listens on
+    quint16 port;
+    {
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+        port = server.serverPort();
+    }
+
+    HddTemp hddTemp(QStringLiteral("127.0.0.1"), port);
+    QTRY_VERIFY(hddTemp.isBackingOff());
+    QVERIFY(hddTemp.sources().isEmpty());
+
+    // no new attempt until the backoff is over
+    FakeHddTempServer server;
+    if (server.listen(QHostAddress::LocalHost, port)) {
+        hddTemp.update();
+        QTest::qWait(200);
+        QCOMPARE(server.connectionCount, 0);
+    }
+}
+
+void HddTempTest::testSilentDaemon()
+{
+    FakeHddTempServer server;
+    server.silent = true;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QElapsedTimer timer;
+    timer.start();
+    HddTemp hddTemp(QStringLiteral("127.0.0.1"), server.serverPort());
+    hddTemp.update();
+    // nothing waits for the daemon
+    QVERIFY(timer.elapsed() < 100);
+
+    QTRY_COMPARE(server.connectionCount, 1);
+    QTRY_VERIFY_WITH_TIMEOUT(hddTemp.isBackingOff(), 5000);
+    QVERIFY(hddTemp.sources().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(HddTempTest)
+
+#include "hddtemptest.moc"
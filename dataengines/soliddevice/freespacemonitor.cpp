@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#include "freespacemonitor.h"
+
+#include <QFile>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include <sys/statvfs.h>
+
+// after this long, the file system is reported as not responding
+static const int s_timeout = 15000;
+// network mounts answering slower than this are polled less often
+static const int s_slowThreshold = 500;
+// how long to wait before polling a mount again which answered slowly or failed
+static const int s_minBackoff = 5000;
+static const int s_maxBackoff = 10 * 60 * 1000;
+
+// statvfs() on a mount which does not respond can hang for as long as the mount does, holding
+// its thread. Such a mount is not polled again before it answered, so there is at most one
+// thread stuck per mount. The pool is never deleted, its destructor would wait for them.
+static QThreadPool *pollingPool()
+{
+    static QThreadPool *pool = [] {
+        auto *threadPool = new QThreadPool;
+        threadPool->setMaxThreadCount(32);
+        return threadPool;
+    }();
+    return pool;
+}
+
+static FreeSpaceMonitor::Result statFileSystem(const QString &path)
+{
+    FreeSpaceMonitor::Result result;
+    result.path = path;
+
+    struct statvfs info;
+    if (statvfs(QFile::encodeName(path).constData(), &info) == 0) {
+        result.valid = true;
+        result.size = quint64(info.f_blocks) * info.f_frsize;
+        result.available = quint64(info.f_bavail) * info.f_frsize;
+    }
+    return result;
+}
+
+FreeSpaceMonitor::FreeSpaceMonitor(QObject *parent)
+    : QObject(parent)
+{
+    m_batchTimer.setSingleShot(true);
+    m_batchTimer.setInterval(0);
+    connect(&m_batchTimer, &QTimer::timeout, this, &FreeSpaceMonitor::pollBatch);
+
+    m_timeoutTimer.setInterval(1000);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &FreeSpaceMonitor::checkTimeouts);
+}
+
+void FreeSpaceMonitor::update(const QString &udi, const QString &path, bool network)
+{
+    const QString previousPath = m_udiPaths.value(udi);
+    if (previousPath != path) {
+        m_spaces.remove(udi);
+    }
+    m_udiPaths.insert(udi, path);
+
+    Mount &mount = m_mounts[path];
+    mount.network = network;
+    if (mount.inFlight || !mount.nextPoll.hasExpired()) {
+        return;
+    }
+    mount.inFlight = true;
+    m_batchTimer.start();
+}
+
+void FreeSpaceMonitor::remove(const QString &udi)
+{
+    const QString path = m_udiPaths.take(udi);
+    m_spaces.remove(udi);
+
+    const QList<QString> paths = m_udiPaths.values();
+    if (!path.isEmpty() && !paths.contains(path)) {
+        m_mounts.remove(path);
+    }
+}
+
+void FreeSpaceMonitor::pollBatch()
+{
+    for (auto it = m_mounts.begin(); it != m_mounts.end(); ++it) {
+        Mount &mount = it.value();
+        if (!mount.inFlight || mount.started.isValid()) {
+            continue;
+        }
+        mount.started.start();
+        startPolling(it.key());
+    }
+
+    if (!m_timeoutTimer.isActive()) {
+        m_timeoutTimer.start();
+    }
+}
+
+void FreeSpaceMonitor::startPolling(const QString &path)
+{
+    // The watcher goes away with the monitor, a result which comes in later is dropped
+    auto *watcher = new QFutureWatcher<Result>(this);
+    connect(watcher, &QFutureWatcher<Result>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        handleResult(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(pollingPool(), statFileSystem, path));
+}
+
+void FreeSpaceMonitor::checkTimeouts()
+{
+    bool inFlight = false;
+    for (auto it = m_mounts.begin(); it != m_mounts.end(); ++it) {
+        Mount &mount = it.value();
+        if (!mount.started.isValid()) {
+            continue;
+        }
+        inFlight = true;
+        if (!mount.notResponding && mount.started.hasExpired(s_timeout)) {
+            mount.notResponding = true;
+            Q_EMIT notResponding(it.key());
+        }
+    }
+    if (!inFlight) {
+        m_timeoutTimer.stop();
+    }
+}
+
+void FreeSpaceMonitor::handleResult(const Result &result)
+{
+    auto mountIt = m_mounts.find(result.path);
+    if (mountIt == m_mounts.end()) {
+        // removed meanwhile
+        return;
+    }
+    Mount &mount = mountIt.value();
+
+    // Mounts which fail are retried later, network mounts also when they are slow
+    const qint64 duration = mount.started.elapsed();
+    if (!result.valid || (mount.network && duration > s_slowThreshold)) {
+        mount.backoff = std::clamp(mount.backoff * 2, s_minBackoff, s_maxBackoff);
+    } else {
+        mount.backoff = 0;
+    }
+    mount.nextPoll.setRemainingTime(mount.backoff);
+    mount.inFlight = false;
+    mount.notResponding = false;
+    mount.started.invalidate();
+
+    if (!result.valid) {
+        return;
+    }
+
+    for (auto it = m_udiPaths.cbegin(); it != m_udiPaths.cend(); ++it) {
+        if (it.value() != result.path) {
+            continue;
+        }
+        auto spaceIt = m_spaces.find(it.key());
+        if (spaceIt != m_spaces.end() && spaceIt->size == result.size && spaceIt->available == result.available) {
+            continue;
+        }
+        m_spaces.insert(it.key(), {result.size, result.available});
+        Q_EMIT freeSpaceChanged(it.key(), result.size, result.available);
+    }
+}
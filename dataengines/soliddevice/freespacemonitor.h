@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-only
+*/
+
+#pragma once
+
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+/**
+ * Polls the free space of mounted file systems.
+ *
+ * The mounts requested within one event loop pass are polled together with statvfs(),
+ * off the GUI thread, each in its own task, so a mount which does not respond cannot hold
+ * back the others. Every mount has its own timeout, after which notResponding() is emitted.
+ * Mounts which fail to answer, and network mounts which are slow to, are polled less often.
+ */
+class FreeSpaceMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FreeSpaceMonitor(QObject *parent = nullptr);
+
+    /**
+     * Polls the file system mounted at @p path with the next batch, for @p udi
+     */
+    void update(const QString &udi, const QString &path, bool network);
+    void remove(const QString &udi);
+
+    struct Result {
+        QString path;
+        bool valid = false;
+        quint64 size = 0;
+        quint64 available = 0;
+    };
+
+Q_SIGNALS:
+    /**
+     * Emitted when the values for @p udi are different from the last ones
+     */
+    void freeSpaceChanged(const QString &udi, quint64 size, quint64 available);
+    /**
+     * Emitted once when the file system at @p path takes too long to answer
+     */
+    void notResponding(const QString &path);
+
+private:
+    struct Mount {
+        bool network = false;
+        bool inFlight = false;
+        bool notResponding = false;
+        QElapsedTimer started;
+        QDeadlineTimer nextPoll = QDeadlineTimer(0);
+        int backoff = 0;
+    };
+    struct Space {
+        quint64 size = 0;
+        quint64 available = 0;
+    };
+    void pollBatch();
+    void startPolling(const QString &path);
+    void checkTimeouts();
+    void handleResult(const Result &result);
+
+    QHash<QString, QString> m_udiPaths;
+    QHash<QString, Mount> m_mounts;
+    QHash<QString, Space> m_spaces;
+    QTimer m_batchTimer;
+    QTimer m_timeoutTimer;
+};
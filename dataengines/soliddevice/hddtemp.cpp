@@ -9,78 +9,137 @@
 
 #include <QTcpSocket>
 
-#include <QTimerEvent>
-
 #include <QDebug>
 
+#include <algorithm>
+
+static const int s_timeout = 2000;
+static const int s_firstRetryDelay = 1000;
+static const int s_maxRetryDelay = 5 * 60 * 1000;
+// hddtemp only sends a few fields per drive
+static const int s_maxDataSize = 64 * 1024;
+
 HddTemp::HddTemp(QObject *parent)
+    : HddTemp(QStringLiteral("localhost"), 7634, parent)
+{
+}
+
+HddTemp::HddTemp(const QString &hostName, quint16 port, QObject *parent)
     : QObject(parent)
+    , m_hostName(hostName)
+    , m_port(port)
+    , m_socket(new QTcpSocket(this))
+    , m_retryDeadline(0)
 {
-    updateData();
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(s_timeout);
+    connect(&m_timeout, &QTimer::timeout, this, &HddTemp::failQuery);
+
+    connect(m_socket, &QTcpSocket::readyRead, this, &HddTemp::readData);
+    // the daemon closes the connection once everything is sent
+    connect(m_socket, &QTcpSocket::disconnected, this, &HddTemp::finishQuery);
+    connect(m_socket, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError error) {
+        if (error != QAbstractSocket::RemoteHostClosedError) {
+            failQuery();
+        }
+    });
+
+    update();
 }
 
 HddTemp::~HddTemp()
 {
 }
 
-QStringList HddTemp::sources()
+QStringList HddTemp::sources() const
 {
-    updateData();
     return m_data.keys();
 }
 
-void HddTemp::timerEvent(QTimerEvent *event)
+bool HddTemp::isBackingOff() const
 {
-    killTimer(event->timerId());
-    m_cacheValid = false;
+    return !m_retryDeadline.hasExpired();
 }
 
-bool HddTemp::updateData()
+void HddTemp::update()
 {
-    if (m_cacheValid) {
-        return true;
+    if (m_querying || isBackingOff()) {
+        return;
     }
+    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
+        m_socket->abort();
+    }
+
+    m_buffer.clear();
+    m_fields.clear();
+    m_pendingData.clear();
 
-    if (m_failCount > 4) {
-        return false;
+    m_querying = true;
+    m_timeout.start();
+    m_socket->connectToHost(m_hostName, m_port);
+}
+
+void HddTemp::readData()
+{
+    m_buffer += m_socket->readAll();
+    if (m_buffer.size() > s_maxDataSize) {
+        qWarning() << "Unexpected data from hddtemp, giving up";
+        failQuery();
+        return;
     }
+    parseFields();
+}
+
+// The data looks like |/dev/sda|Model|40|C||/dev/sdb|Model|38|C|
+void HddTemp::parseFields()
+{
+    int start = 0;
+    for (int end = m_buffer.indexOf('|'); end != -1; end = m_buffer.indexOf('|', start)) {
+        m_fields.append(m_buffer.mid(start, end - start));
+        start = end + 1;
 
-    QTcpSocket socket;
-    QString data;
-
-    socket.connectToHost(QStringLiteral("localhost"), 7634);
-    if (socket.waitForConnected(500)) {
-        while (data.length() < 1024) {
-            if (!socket.waitForReadyRead(500)) {
-                if (data.length() > 0) {
-                    break;
-                } else {
-                    // qDebug() << socket.errorString();
-                    return false;
-                }
-            }
-            data += QString(socket.readAll());
+        // an empty field, then device, model, temperature and unit
+        if (m_fields.size() == 5) {
+            QList<QVariant> &values = m_pendingData[QString::fromUtf8(m_fields.at(1))];
+            values.clear();
+            values << QString::fromUtf8(m_fields.at(3)) << QString::fromUtf8(m_fields.at(4));
+            m_fields.clear();
         }
-        socket.disconnectFromHost();
-        // on success retry fail count
-        m_failCount = 0;
-    } else {
-        m_failCount++;
-        // qDebug() << socket.errorString();
-        return false;
     }
-    const QStringList list = data.split('|');
-    int i = 1;
-    m_data.clear();
-    while (i + 4 < list.size()) {
-        m_data[list[i]].append(list[i + 2]);
-        m_data[list[i]].append(list[i + 3]);
-        i += 5;
+    m_buffer.remove(0, start);
+}
+
+void HddTemp::finishQuery()
+{
+    if (!m_querying) {
+        // failed already
+        return;
+    }
+    m_querying = false;
+    m_timeout.stop();
+
+    // on success reset fail count
+    m_failCount = 0;
+
+    if (m_pendingData != m_data) {
+        m_data = m_pendingData;
+        Q_EMIT dataChanged();
+    }
+}
+
+void HddTemp::failQuery()
+{
+    if (!m_querying) {
+        return;
     }
-    m_cacheValid = true;
-    startTimer(0);
+    m_querying = false;
+    m_timeout.stop();
+    m_socket->abort();
 
-    return true;
+    // back off, the daemon most likely is not running
+    const int delay = std::min<qint64>(qint64(s_firstRetryDelay) << std::min(m_failCount, 20), s_maxRetryDelay);
+    m_retryDeadline.setRemainingTime(delay);
+    ++m_failCount;
 }
 
 QVariant HddTemp::data(const QString source, const DataType type) const
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <QByteArray>
+#include <QDeadlineTimer>
 #include <QMap>
 #include <QObject>
 #include <QString>
@@ -14,6 +16,15 @@
 #include <QTimer>
 #include <QVariant>
 
+class QTcpSocket;
+
+/**
+ * Client of the hddtemp daemon, which sends the temperatures of all drives to every connection.
+ *
+ * Nothing blocks: update() starts a query in the background, the last known values stay
+ * available meanwhile and dataChanged() tells when they changed. While the daemon cannot be
+ * reached, queries are retried less and less often.
+ */
 class HddTemp : public QObject
 {
     Q_OBJECT
@@ -25,16 +36,43 @@ public:
     };
 
     explicit HddTemp(QObject *parent = nullptr);
+    HddTemp(const QString &hostName, quint16 port, QObject *parent = nullptr);
     ~HddTemp() override;
-    QStringList sources();
+
+    /**
+     * The drives of the last successful query
+     */
+    QStringList sources() const;
     QVariant data(const QString source, const DataType type) const;
 
-protected:
-    void timerEvent(QTimerEvent *event) override;
+    /**
+     * Queries the daemon, unless a query is running already or the daemon was not reachable recently
+     */
+    void update();
+
+    /**
+     * Whether queries are held back because the daemon was not reachable
+     */
+    bool isBackingOff() const;
+
+Q_SIGNALS:
+    void dataChanged();
 
 private:
+    void readData();
+    void parseFields();
+    void finishQuery();
+    void failQuery();
+
+    QString m_hostName;
+    quint16 m_port;
+    QTcpSocket *m_socket;
+    QTimer m_timeout;
+    bool m_querying = false;
+    QByteArray m_buffer;
+    QList<QByteArray> m_fields;
+    QMap<QString, QList<QVariant>> m_pendingData;
     int m_failCount = 0;
-    bool m_cacheValid = false;
+    QDeadlineTimer m_retryDeadline;
     QMap<QString, QList<QVariant>> m_data;
-    bool updateData();
 };
@@ -11,6 +11,7 @@
 #include <QDateTime>
 #include <QMetaEnum>
 #include <Solid/GenericInterface>
+#include <solid/networkshare.h>
 #include <klocalizedstring.h>
 
 #include <KFormat>
@@ -38,6 +39,7 @@ DevIface *getAncestorAs(const Solid::Device &device)
 SolidDeviceEngine::SolidDeviceEngine(QObject *parent, const QVariantList &args)
     : Plasma::DataEngine(parent, args)
     , m_temperature(nullptr)
+    , m_freeSpace(nullptr)
     , m_notifier(nullptr)
 {
     Q_UNUSED(args)
@@ -527,40 +529,22 @@ bool SolidDeviceEngine::updateStorageSpace(const QString &udi)
         return false;
     }
 
-    QString path = storageaccess->filePath();
-    if (!m_paths.contains(path)) {
-        QTimer *timer = new QTimer(this);
-        timer->setSingleShot(true);
-        connect(timer, &QTimer::timeout, [path]() {
-            KNotification::event(KNotification::Error, i18n("Filesystem is not responding"), i18n("Filesystem mounted at '%1' is not responding", path));
+    if (!m_freeSpace) {
+        m_freeSpace = new FreeSpaceMonitor(this);
+        connect(m_freeSpace, &FreeSpaceMonitor::freeSpaceChanged, this, [this](const QString &udi, quint64 size, quint64 available) {
+            setData(udi, kli18n("Free Space").untranslatedText(), QVariant(available).toDouble());
+            setData(udi, kli18n("Free Space Text").untranslatedText(), KFormat().formatByteSize(available));
+            setData(udi, kli18n("Size").untranslatedText(), QVariant(size).toDouble());
+            setData(udi, kli18n("Size Text").untranslatedText(), KFormat().formatByteSize(size));
         });
-
-        m_paths.insert(path);
-
-        // create job
-        KIO::FileSystemFreeSpaceJob *job = KIO::fileSystemFreeSpace(QUrl::fromLocalFile(path));
-
-        // delete later timer
-        connect(job, &KIO::FileSystemFreeSpaceJob::result, timer, &QTimer::deleteLater);
-
-        // collect and process info
-        connect(job, &KIO::FileSystemFreeSpaceJob::result, this, [this, timer, path, udi](KIO::Job *job, KIO::filesize_t size, KIO::filesize_t available) {
-            timer->stop();
-
-            if (!job->error()) {
-                setData(udi, kli18n("Free Space").untranslatedText(), QVariant(available).toDouble());
-                setData(udi, kli18n("Free Space Text").untranslatedText(), KFormat().formatByteSize(available));
-                setData(udi, kli18n("Size").untranslatedText(), QVariant(size).toDouble());
-                setData(udi, kli18n("Size Text").untranslatedText(), KFormat().formatByteSize(size));
-            }
-
-            m_paths.remove(path);
+        connect(m_freeSpace, &FreeSpaceMonitor::notResponding, this, [](const QString &path) {
+            KNotification::event(KNotification::Error, i18n("Filesystem is not responding"), i18n("Filesystem mounted at '%1' is not responding", path));
         });
-
-        // start timer: after 15 seconds we will get an error
-        timer->start(15000);
     }
 
+    // polled with all the other mounts, the values come in later
+    m_freeSpace->update(udi, storageaccess->filePath(), device.is<Solid::NetworkShare>());
+
     return false;
 }
 
@@ -574,6 +558,25 @@ bool SolidDeviceEngine::updateHardDiskTemperature(const QString &udi)
 
     if (!m_temperature) {
         m_temperature = new HddTemp(this);
+        // the query runs in the background, publish the temperatures once they are in
+        connect(m_temperature, &HddTemp::dataChanged, this, [this]() {
+            const QStringList udis = sources();
+            for (const QString &udi : udis) {
+                setHardDiskTemperature(udi);
+            }
+        });
+    }
+    m_temperature->update();
+
+    return setHardDiskTemperature(udi);
+}
+
+bool SolidDeviceEngine::setHardDiskTemperature(const QString &udi)
+{
+    Solid::Device device = m_devicemap.value(udi);
+    Solid::Block *block = device.as<Solid::Block>();
+    if (!block || !m_temperature) {
+        return false;
     }
 
     if (m_temperature->sources().contains(block->device())) {
@@ -672,6 +675,9 @@ void SolidDeviceEngine::deviceRemoved(const QString &udi)
         }
     }
 
+    if (m_freeSpace) {
+        m_freeSpace->remove(udi);
+    }
     m_devicemap.remove(udi);
     removeSource(udi);
 }
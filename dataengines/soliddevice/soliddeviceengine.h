@@ -19,8 +19,8 @@
 
 #include "devicesignalmapmanager.h"
 #include "devicesignalmapper.h"
+#include "freespacemonitor.h"
 #include "hddtemp.h"
-#include <KIO/FileSystemFreeSpaceJob>
 #include <Plasma/DataEngine>
 #include <Plasma/Service>
 
@@ -57,6 +57,7 @@ private:
     bool populateDeviceData(const QString &name);
     bool updateStorageSpace(const QString &udi);
     bool updateHardDiskTemperature(const QString &udi);
+    bool setHardDiskTemperature(const QString &udi);
     bool updateEmblems(const QString &udi);
     bool updateInUse(const QString &udi);
     bool forceUpdateAccessibility(const QString &udi);
@@ -68,11 +69,10 @@ private:
     QMap<QString, Solid::Device> m_devicemap;
     // udi, corresponding encrypted container udi;
     QMap<QString, QString> m_encryptedContainerMap;
-    // path, for pending file system free space jobs
-    QSet<QString> m_paths;
     DeviceSignalMapManager *m_signalmanager;
 
     HddTemp *m_temperature;
+    FreeSpaceMonitor *m_freeSpace;
     Solid::DeviceNotifier *m_notifier;
 
 private Q_SLOTS:
@@ -7,12 +7,10 @@
 
 #pragma once
 
-#include "statusnotifierwatcher_interface.h"
 #include <Plasma/DataEngine>
 #include <Plasma/Service>
-#include <QDBusConnection>
 
-// Define our plasma Runner
+// The items come from the StatusNotifierItemHost shared with the system tray applet
 class StatusNotifierItemEngine : public Plasma::DataEngine
 {
     Q_OBJECT
@@ -23,19 +21,6 @@ public:
     ~StatusNotifierItemEngine() override;
     Plasma::Service *serviceForSource(const QString &name) override;
 
-protected:
-    virtual void init();
-    void newItem(const QString &service);
-
-protected Q_SLOTS:
-    void serviceChange(const QString &name, const QString &oldOwner, const QString &newOwner);
-    void registerWatcher(const QString &service);
-    void unregisterWatcher(const QString &service);
-    void serviceRegistered(const QString &service);
-    void serviceUnregistered(const QString &service);
-
 private:
-    org::kde::StatusNotifierWatcher *m_statusNotifierWatcher;
-    QString m_serviceName;
-    static const int s_protocolVersion = 0;
+    void newItem(const QString &service);
 };
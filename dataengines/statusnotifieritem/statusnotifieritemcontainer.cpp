@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2009 Marco Martin <notmart@gmail.com>
+    SPDX-FileCopyrightText: 2009 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "statusnotifieritemcontainer.h"
+#include "statusnotifieritemsource.h"
+
+#include <QIcon>
+
+StatusNotifierItemContainer::StatusNotifierItemContainer(StatusNotifierItemSource *source, QObject *parent)
+    : Plasma::DataContainer(parent)
+    , m_source(source)
+{
+    setObjectName(source->objectName());
+
+    // set the initial values for all the things
+    // this is important as Plasma::DataModel has an unsolvable bug
+    // when it gets data with a new key it tries to update the  QAIM roleNames
+    // from QML this achieves absolutely nothing as there is no signal to tell QQmlDelegateModel to reload the roleNames in QQmlAdapatorModel
+    // no matter if the row changes or the model refreshes
+    // this means it does not re-evaluate what bindings exist (watchedRoleIds) - and we get properties that don't bind and thus system tray icons
+
+    // by setting everything up-front so that we have all role names when we call the first checkForUpdate()
+    setData(QStringLiteral("AttentionIcon"), QIcon());
+    setData(QStringLiteral("AttentionIconName"), QString());
+    setData(QStringLiteral("AttentionMovieName"), QString());
+    setData(QStringLiteral("Category"), QString());
+    setData(QStringLiteral("Icon"), QIcon());
+    setData(QStringLiteral("IconName"), QString());
+    setData(QStringLiteral("IconsChanged"), false);
+    setData(QStringLiteral("IconThemePath"), QString());
+    setData(QStringLiteral("Id"), QString());
+    setData(QStringLiteral("ItemIsMenu"), false);
+    setData(QStringLiteral("OverlayIconName"), QString());
+    setData(QStringLiteral("StatusChanged"), false);
+    setData(QStringLiteral("Status"), QString());
+    setData(QStringLiteral("TitleChanged"), false);
+    setData(QStringLiteral("Title"), QString());
+    setData(QStringLiteral("ToolTipChanged"), false);
+    setData(QStringLiteral("ToolTipIcon"), QString());
+    setData(QStringLiteral("ToolTipSubTitle"), QString());
+    setData(QStringLiteral("ToolTipTitle"), QString());
+    setData(QStringLiteral("WindowId"), QVariant());
+
+    connect(source, &StatusNotifierItemSource::dataUpdated, this, &StatusNotifierItemContainer::updateData);
+
+    // The item may have been around for a while already, with everything fetched
+    if (!source->id().isEmpty() || !source->status().isEmpty()) {
+        updateData();
+    }
+}
+
+StatusNotifierItemContainer::~StatusNotifierItemContainer() = default;
+
+StatusNotifierItemSource *StatusNotifierItemContainer::source() const
+{
+    return m_source;
+}
+
+// QVariant cannot compare icons, these are the same as long as they share their data
+static bool sameValue(const QVariant &previous, const QVariant &value)
+{
+    if (previous.userType() == QMetaType::QIcon || value.userType() == QMetaType::QIcon) {
+        return previous.userType() == value.userType() && previous.value<QIcon>().cacheKey() == value.value<QIcon>().cacheKey();
+    }
+    return previous == value;
+}
+
+void StatusNotifierItemContainer::updateData()
+{
+    if (!m_source) {
+        return;
+    }
+
+    const Plasma::DataEngine::Data previous = data();
+
+    // record what has changed
+    const bool titleChanged = previous.value(QStringLiteral("Title")).toString() != m_source->title();
+    const bool iconsChanged = !sameValue(previous.value(QStringLiteral("Icon")), m_source->icon())
+        || !sameValue(previous.value(QStringLiteral("AttentionIcon")), m_source->attentionIcon())
+        || previous.value(QStringLiteral("IconName")).toString() != m_source->iconName()
+        || previous.value(QStringLiteral("AttentionIconName")).toString() != m_source->attentionIconName()
+        || previous.value(QStringLiteral("OverlayIconName")).toString() != m_source->overlayIconName()
+        || previous.value(QStringLiteral("AttentionMovieName")).toString() != m_source->attentionMovieName();
+    const bool toolTipChanged = previous.value(QStringLiteral("ToolTipTitle")).toString() != m_source->toolTipTitle()
+        || previous.value(QStringLiteral("ToolTipSubTitle")).toString() != m_source->toolTipSubTitle()
+        || !sameValue(previous.value(QStringLiteral("ToolTipIcon")), m_source->toolTipIcon());
+    const bool statusChanged = previous.value(QStringLiteral("Status")).toString() != m_source->status();
+
+    setData(QStringLiteral("TitleChanged"), titleChanged);
+    setData(QStringLiteral("IconsChanged"), iconsChanged);
+    setData(QStringLiteral("ToolTipChanged"), toolTipChanged);
+    setData(QStringLiteral("StatusChanged"), statusChanged);
+
+    setData(QStringLiteral("AttentionIcon"), m_source->attentionIcon());
+    setData(QStringLiteral("AttentionIconName"), m_source->attentionIconName());
+    setData(QStringLiteral("AttentionMovieName"), m_source->attentionMovieName());
+    setData(QStringLiteral("Category"), m_source->category());
+    setData(QStringLiteral("Icon"), m_source->icon());
+    setData(QStringLiteral("IconName"), m_source->iconName());
+    setData(QStringLiteral("IconThemePath"), m_source->iconThemePath());
+    setData(QStringLiteral("Id"), m_source->id());
+    setData(QStringLiteral("ItemIsMenu"), m_source->itemIsMenu());
+    setData(QStringLiteral("OverlayIconName"), m_source->overlayIconName());
+    setData(QStringLiteral("Status"), m_source->status());
+    setData(QStringLiteral("Title"), m_source->title());
+    setData(QStringLiteral("ToolTipIcon"), m_source->toolTipIcon());
+    setData(QStringLiteral("ToolTipSubTitle"), m_source->toolTipSubTitle());
+    setData(QStringLiteral("ToolTipTitle"), m_source->toolTipTitle());
+
+    const QString windowId = m_source->windowId();
+    setData(QStringLiteral("WindowId"), windowId.isEmpty() ? QVariant() : QVariant(windowId.toInt()));
+
+    checkForUpdate();
+}
@@ -0,0 +1,34 @@
+/*
+    SPDX-FileCopyrightText: 2009 Marco Martin <notmart@gmail.com>
+    SPDX-FileCopyrightText: 2009 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <Plasma/DataContainer>
+#include <QPointer>
+
+class StatusNotifierItemSource;
+
+/**
+ * Publishes a StatusNotifierItem of the shared StatusNotifierItemHost as a data source,
+ * without fetching or decoding anything on its own.
+ */
+class StatusNotifierItemContainer : public Plasma::DataContainer
+{
+    Q_OBJECT
+
+public:
+    StatusNotifierItemContainer(StatusNotifierItemSource *source, QObject *parent);
+    ~StatusNotifierItemContainer() override;
+
+    StatusNotifierItemSource *source() const;
+
+private Q_SLOTS:
+    void updateData();
+
+private:
+    QPointer<StatusNotifierItemSource> m_source;
+};
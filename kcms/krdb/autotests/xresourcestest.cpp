@@ -0,0 +1,97 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <config-X11.h>
+
+#include <QTest>
+
+#include "../xresources.h"
+
+class XResourcesTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testParse();
+    void testContinuationLines();
+    void testNeedsPreprocessor();
+    void testSerializeRoundTrip();
+    void testMerge();
+};
+
+void XResourcesTest::testParse()
+{
+    const XResources::Database database = XResources::parse(
+        "! a comment\n"
+        "\n"
+        "Xcursor.theme: breeze_cursors\n"
+        "  *background:\t#ffffff\n"
+        "Xft.dpi: 96\n"
+        "no separator here\n"
+        "Xft.dpi: 120\n");
+
+    QCOMPARE(database.size(), 3);
+    QCOMPARE(database.value("Xcursor.theme"), QByteArray("breeze_cursors"));
+    QCOMPARE(database.value("*background"), QByteArray("#ffffff"));
+    // The last definition wins
+    QCOMPARE(database.value("Xft.dpi"), QByteArray("120"));
+}
+
+void XResourcesTest::testContinuationLines()
+{
+    const XResources::Database database = XResources::parse(
+        "XTerm*translations: #override \\\n"
+        "    Ctrl <Key>minus: smaller-vt-font()\n"
+        "Xft.antialias: 1\n");
+
+    QCOMPARE(database.size(), 2);
+    QCOMPARE(database.value("XTerm*translations"), QByteArray("#override \\\n    Ctrl <Key>minus: smaller-vt-font()"));
+    QCOMPARE(database.value("Xft.antialias"), QByteArray("1"));
+}
+
+void XResourcesTest::testNeedsPreprocessor()
+{
+    QVERIFY(!XResources::needsPreprocessor("Xft.dpi: 96\n*background: #ffffff\n"));
+    QVERIFY(XResources::needsPreprocessor("#include \".Xresources.d/colors\"\nXft.dpi: 96\n"));
+    QVERIFY(XResources::needsPreprocessor("#define FG #000000\n*foreground: FG\n"));
+}
+
+void XResourcesTest::testSerializeRoundTrip()
+{
+    const XResources::Database database = XResources::parse("b.resource: 2\na.resource: one two\n");
+    const QByteArray data = XResources::serialize(database);
+    QCOMPARE(data, QByteArray("a.resource:\tone two\nb.resource:\t2\n"));
+    QCOMPARE(XResources::parse(data), database);
+}
+
+void XResourcesTest::testMerge()
+{
+#if HAVE_X11
+    if (qEnvironmentVariableIsEmpty("DISPLAY")) {
+        QSKIP("Needs an X server, run under Xvfb");
+    }
+
+    const QByteArray name("krdbTest.resource");
+    XResources::merge({}, {name});
+
+    QVERIFY(XResources::merge({{name, "first"}}));
+    QCOMPARE(XResources::query().value(name), QByteArray("first"));
+
+    // Nothing changes, so the property is not touched
+    QVERIFY(!XResources::merge({{name, "first"}}));
+
+    QVERIFY(XResources::merge({{name, "second"}}));
+    QCOMPARE(XResources::query().value(name), QByteArray("second"));
+
+    QVERIFY(XResources::merge({}, {name}));
+    QVERIFY(!XResources::query().contains(name));
+#else
+    QSKIP("Built without X11 support");
+#endif
+}
+
+QTEST_GUILESS_MAIN(XResourcesTest)
+
+#include "xresourcestest.moc"
@@ -1,7 +1,6 @@
 /*
-    KRDB - puts current KDE color scheme into preprocessor statements
-    cats specially written application default files and uses xrdb -merge to
-    write to RESOURCE_MANAGER. Thus it gives a  simple way to make non-KDE
+    KRDB - merges the user's X resources and the KDE cursor and font settings
+    into RESOURCE_MANAGER. Thus it gives a  simple way to make non-KDE
     applications fit in with the desktop
 
     SPDX-FileCopyrightText: 1998 Mark Donohoe
@@ -37,7 +36,6 @@
 #include <QDebug>
 #include <QPixmap>
 #include <QSaveFile>
-#include <QTemporaryFile>
 #include <QTextStream>
 
 #include <KColorScheme>
@@ -50,6 +48,7 @@
 #include <updatelaunchenvjob.h>
 
 #include "krdb.h"
+#include "xresources.h"
 #if HAVE_X11
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #include <private/qtx11extras_p.h>
@@ -231,21 +230,6 @@ static void applyQtSettings(KSharedConfigPtr kglobalcfg, QSettings &settings)
 
 // -----------------------------------------------------------------------------
 
-static void copyFile(QFile &tmp, QString const &filename, bool)
-{
-    QFile f(filename);
-    if (f.open(QIODevice::ReadOnly)) {
-        QByteArray buf(8192, ' ');
-        while (!f.atEnd()) {
-            int read = f.read(buf.data(), buf.size());
-            if (read > 0)
-                tmp.write(buf.data(), read);
-        }
-    }
-}
-
-// -----------------------------------------------------------------------------
-
 static void createGtkrc(const QPalette &cg, bool exportGtkTheme, const QString &gtkTheme, int version)
 {
     Q_UNUSED(cg);
@@ -336,12 +320,6 @@ void runRdb(uint flags)
     KConfigGroup kglobals(kglobalcfg, "KDE");
     QPalette newPal = KColorScheme::createApplicationPalette(kglobalcfg);
 
-    QTemporaryFile tmpFile;
-    if (!tmpFile.open()) {
-        qDebug() << "Couldn't open temp file";
-        exit(0);
-    }
-
     KConfigGroup generalCfgGroup(kglobalcfg, "General");
 
     QString gtkTheme;
@@ -356,18 +334,20 @@ void runRdb(uint flags)
     // Merge ~/.Xresources or fallback to ~/.Xdefaults
     QString homeDir = QDir::homePath();
     QString xResources = homeDir + "/.Xresources";
+    if (!QFile::exists(xResources))
+        xResources = homeDir + "/.Xdefaults";
 
-    // very primitive support for ~/.Xresources by appending it
-    if (QFile::exists(xResources))
-        copyFile(tmpFile, xResources, true);
-    else
-        copyFile(tmpFile, homeDir + "/.Xdefaults", true);
+    QByteArray userResources;
+    QFile userResourcesFile(xResources);
+    if (userResourcesFile.open(QIODevice::ReadOnly))
+        userResources = userResourcesFile.readAll();
 
     // Export the Xcursor theme & size settings
     KConfigGroup mousecfg(KSharedConfig::openConfig(QStringLiteral("kcminputrc")), "Mouse");
     QString theme = mousecfg.readEntry("cursorTheme", QStringLiteral("breeze_cursors"));
     QString size = mousecfg.readEntry("cursorSize", QStringLiteral("24"));
     QString contents;
+    QByteArrayList removedResources;
 
     if (!theme.isNull())
         contents = "Xcursor.theme: " + theme + '\n';
@@ -415,53 +395,24 @@ void runRdb(uint flags)
         }
         if (dpi != 0)
             contents += "Xft.dpi: " + QString::number(dpi) + '\n';
-        else {
-            KProcess queryProc;
-            queryProc << QStringLiteral("xrdb") << QStringLiteral("-query");
-            queryProc.setOutputChannelMode(KProcess::OnlyStdoutChannel);
-            queryProc.start();
-            if (queryProc.waitForFinished()) {
-                QByteArray db = queryProc.readAllStandardOutput();
-                int idx1 = 0;
-                while (idx1 < db.size()) {
-                    int idx2 = db.indexOf('\n', idx1);
-                    if (idx2 == -1) {
-                        idx2 = db.size() - 1;
-                    }
-                    const auto entry = QByteArray::fromRawData(db.constData() + idx1, idx2 - idx1 + 1);
-                    if (entry.startsWith("Xft.dpi:")) {
-                        db.remove(idx1, entry.size());
-                    } else {
-                        idx1 = idx2 + 1;
-                    }
-                }
-
-                KProcess loadProc;
-                loadProc << QStringLiteral("xrdb") << QStringLiteral("-quiet") << QStringLiteral("-load") << QStringLiteral("-nocpp");
-                loadProc.start();
-                if (loadProc.waitForStarted()) {
-                    loadProc.write(db);
-                    loadProc.closeWriteChannel();
-                    loadProc.waitForFinished();
-                }
-            }
-        }
+        else
+            removedResources << QByteArrayLiteral("Xft.dpi");
     }
 
-    if (contents.length() > 0)
-        tmpFile.write(contents.toLatin1(), contents.length());
+    XResources::Database resources;
+    if (XResources::needsPreprocessor(userResources)) {
+        // Only xrdb can run the C preprocessor over the user's file
+        XResources::merge({}, removedResources);
+        removedResources.clear();
 
-    tmpFile.flush();
-
-    KProcess proc;
-#ifndef NDEBUG
-    proc << QStringLiteral("xrdb") << QStringLiteral("-merge") << tmpFile.fileName();
-#else
-    proc << "xrdb"
-         << "-quiet"
-         << "-merge" << tmpFile.fileName();
-#endif
-    proc.execute();
+        KProcess proc;
+        proc << QStringLiteral("xrdb") << QStringLiteral("-quiet") << QStringLiteral("-merge") << xResources;
+        proc.execute();
+    } else {
+        resources = XResources::parse(userResources);
+    }
+    resources.insert(XResources::parse(contents.toLatin1()));
+    XResources::merge(resources, removedResources);
 
     applyGtkStyles(1);
     applyGtkStyles(2);
@@ -0,0 +1,203 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <config-X11.h>
+
+#include "xresources.h"
+
+#include <QDebug>
+
+#if HAVE_X11
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#endif
+
+namespace XResources
+{
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+// Splits into logical lines, a backslash at the end of a line continues it on the next one
+static QByteArrayList logicalLines(const QByteArray &data)
+{
+    QByteArrayList lines;
+    QByteArray current;
+    for (const QByteArray &line : data.split('\n')) {
+        int backslashes = 0;
+        for (int i = line.size() - 1; i >= 0 && line.at(i) == '\\'; --i) {
+            ++backslashes;
+        }
+        current += line;
+        if (backslashes % 2 == 1) {
+            current += '\n';
+            continue;
+        }
+        lines << current;
+        current.clear();
+    }
+    if (!current.isEmpty()) {
+        lines << current;
+    }
+    return lines;
+}
+
+Database parse(const QByteArray &data)
+{
+    Database database;
+    for (const QByteArray &line : logicalLines(data)) {
+        int start = 0;
+        while (start < line.size() && isSpace(line.at(start))) {
+            ++start;
+        }
+        if (start == line.size() || line.at(start) == '!' || line.at(start) == '#') {
+            continue;
+        }
+
+        const int colon = line.indexOf(':', start);
+        if (colon < 0) {
+            continue;
+        }
+        const QByteArray name = line.mid(start, colon - start).trimmed();
+        if (name.isEmpty()) {
+            continue;
+        }
+        int valueStart = colon + 1;
+        while (valueStart < line.size() && isSpace(line.at(valueStart))) {
+            ++valueStart;
+        }
+        // Later definitions win, just like in xrdb
+        database.insert(name, line.mid(valueStart));
+    }
+    return database;
+}
+
+QByteArray serialize(const Database &database)
+{
+    QByteArray data;
+    for (auto it = database.cbegin(); it != database.cend(); ++it) {
+        data += it.key() + ":\t" + it.value() + '\n';
+    }
+    return data;
+}
+
+bool needsPreprocessor(const QByteArray &data)
+{
+    for (const QByteArray &line : data.split('\n')) {
+        if (line.trimmed().startsWith('#')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if HAVE_X11
+static bool readProperty(Display *display, QByteArray *contents)
+{
+    contents->clear();
+    long offset = 0;
+    unsigned long remaining = 0;
+    do {
+        Atom type = None;
+        int format = 0;
+        unsigned long count = 0;
+        unsigned char *data = nullptr;
+        if (XGetWindowProperty(display,
+                               DefaultRootWindow(display),
+                               XA_RESOURCE_MANAGER,
+                               offset,
+                               64 * 1024,
+                               False,
+                               XA_STRING,
+                               &type,
+                               &format,
+                               &count,
+                               &remaining,
+                               &data)
+            != Success) {
+            return false;
+        }
+        if (type == XA_STRING && format == 8) {
+            contents->append(reinterpret_cast<const char *>(data), count);
+        }
+        if (data) {
+            XFree(data);
+        }
+        if (type != XA_STRING) {
+            return true;
+        }
+        // The offset is in 32 bit units
+        offset += count / 4;
+    } while (remaining > 0);
+    return true;
+}
+#endif
+
+Database query()
+{
+#if HAVE_X11
+    Display *display = XOpenDisplay(nullptr);
+    if (!display) {
+        return {};
+    }
+    QByteArray contents;
+    readProperty(display, &contents);
+    XCloseDisplay(display);
+    return parse(contents);
+#else
+    return {};
+#endif
+}
+
+bool merge(const Database &resources, const QByteArrayList &removedResources)
+{
+#if HAVE_X11
+    // Our own connection, the application may not be running on X11 at all
+    Display *display = XOpenDisplay(nullptr);
+    if (!display) {
+        qWarning() << "Cannot open the X display to update the X resources";
+        return false;
+    }
+
+    bool changed = false;
+    QByteArray current;
+    if (readProperty(display, &current)) {
+        const Database currentDatabase = parse(current);
+        Database database = currentDatabase;
+        for (const QByteArray &name : removedResources) {
+            database.remove(name);
+        }
+        for (auto it = resources.cbegin(); it != resources.cend(); ++it) {
+            database.insert(it.key(), it.value());
+        }
+
+        if (database != currentDatabase) {
+            const QByteArray updated = serialize(database);
+            XChangeProperty(display,
+                            DefaultRootWindow(display),
+                            XA_RESOURCE_MANAGER,
+                            XA_STRING,
+                            8,
+                            PropModeReplace,
+                            reinterpret_cast<const unsigned char *>(updated.constData()),
+                            updated.size());
+            XSync(display, False);
+            changed = true;
+        }
+    } else {
+        qWarning() << "Cannot read the X resources";
+    }
+
+    XCloseDisplay(display);
+    return changed;
+#else
+    Q_UNUSED(resources)
+    Q_UNUSED(removedResources)
+    return false;
+#endif
+}
+}
@@ -0,0 +1,45 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QMap>
+
+/**
+ * The parts of xrdb krdb needs, done in process.
+ *
+ * Resources are kept the way they are written in a resource file: the name and
+ * the value after the colon, verbatim. Files which use the C preprocessor are
+ * not understood, use needsPreprocessor() to find out.
+ */
+namespace XResources
+{
+using Database = QMap<QByteArray, QByteArray>;
+
+Database parse(const QByteArray &data);
+QByteArray serialize(const Database &database);
+
+/**
+ * Whether @p data contains preprocessor directives such as \#include or \#define
+ */
+bool needsPreprocessor(const QByteArray &data);
+
+/**
+ * Merges @p resources into the RESOURCE_MANAGER property of the X server in $DISPLAY,
+ * after dropping the resources named in @p removedResources, like xrdb -merge does.
+ *
+ * The property is only written if its contents change.
+ * @return whether the property was changed
+ */
+bool merge(const Database &resources, const QByteArrayList &removedResources = {});
+
+/**
+ * The current contents of the RESOURCE_MANAGER property of the X server in $DISPLAY
+ */
+Database query();
+}
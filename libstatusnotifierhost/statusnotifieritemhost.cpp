@@ -12,7 +12,7 @@
 
 #include "dbusproperties.h"
 
-#include "debug.h"
+#include "statusnotifierhost_debug.h"
 #include <iostream>
 
 class StatusNotifierItemHostSingleton
@@ -52,6 +52,15 @@ StatusNotifierItemSource *StatusNotifierItemHost::itemForService(const QString s
     return m_sniServices.value(service);
 }
 
+QHash<QString, QHash<QString, int>> StatusNotifierItemHost::dbusCallCounts() const
+{
+    QHash<QString, QHash<QString, int>> counts;
+    for (auto it = m_sniServices.cbegin(); it != m_sniServices.cend(); ++it) {
+        counts.insert(it.key(), it.value()->dbusCallCounts());
+    }
+    return counts;
+}
+
 void StatusNotifierItemHost::init()
 {
     if (QDBusConnection::sessionBus().isConnected()) {
@@ -68,7 +77,7 @@ void StatusNotifierItemHost::init()
 
 void StatusNotifierItemHost::serviceChange(const QString &name, const QString &oldOwner, const QString &newOwner)
 {
-    qCDebug(SYSTEM_TRAY) << "Service" << name << "status change, old owner:" << oldOwner << "new:" << newOwner;
+    qCDebug(STATUSNOTIFIERHOST) << "Service" << name << "status change, old owner:" << oldOwner << "new:" << newOwner;
 
     if (newOwner.isEmpty()) {
         // unregistered
@@ -118,7 +127,7 @@ void StatusNotifierItemHost::registerWatcher(const QString &service)
         } else {
             delete m_statusNotifierWatcher;
             m_statusNotifierWatcher = nullptr;
-            qCDebug(SYSTEM_TRAY) << "System tray daemon not reachable";
+            qCDebug(STATUSNOTIFIERHOST) << "System tray daemon not reachable";
         }
     }
 }
@@ -126,7 +135,7 @@ void StatusNotifierItemHost::registerWatcher(const QString &service)
 void StatusNotifierItemHost::unregisterWatcher(const QString &service)
 {
     if (service == s_watcherServiceName) {
-        qCDebug(SYSTEM_TRAY) << s_watcherServiceName << "disappeared";
+        qCDebug(STATUSNOTIFIERHOST) << s_watcherServiceName << "disappeared";
 
         disconnect(m_statusNotifierWatcher,
                    &OrgKdeStatusNotifierWatcherInterface::StatusNotifierItemRegistered,
@@ -146,7 +155,7 @@ void StatusNotifierItemHost::unregisterWatcher(const QString &service)
 
 void StatusNotifierItemHost::serviceRegistered(const QString &service)
 {
-    qCDebug(SYSTEM_TRAY) << "Registering" << service;
+    qCDebug(STATUSNOTIFIERHOST) << "Registering" << service;
     addSNIService(service);
 }
 
@@ -162,6 +171,7 @@ void StatusNotifierItemHost::removeAllSNIServices()
         it.next();
 
         StatusNotifierItemSource *item = it.value();
+        qCDebug(STATUSNOTIFIERHOST) << "D-Bus calls made to" << it.key() << item->dbusCallCounts();
         item->disconnect();
         item->deleteLater();
         Q_EMIT itemRemoved(it.key());
@@ -180,6 +190,7 @@ void StatusNotifierItemHost::removeSNIService(const QString &service)
 {
     if (m_sniServices.contains(service)) {
         auto item = m_sniServices.value(service);
+        qCDebug(STATUSNOTIFIERHOST) << "D-Bus calls made to" << service << item->dbusCallCounts();
         item->disconnect();
         item->deleteLater();
         m_sniServices.remove(service);
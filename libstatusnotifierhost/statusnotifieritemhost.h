@@ -7,13 +7,19 @@
 
 #pragma once
 
+#include "statusnotifierhost_export.h"
 #include "statusnotifierwatcher_interface.h"
 #include <QDBusConnection>
 
 class StatusNotifierItemSource;
 
-// Define our plasma Runner
-class StatusNotifierItemHost : public QObject
+/**
+ * The StatusNotifierItems of the session.
+ *
+ * There is one per process, shared by the system tray applet and the statusnotifieritem
+ * dataengine, so that every item is only watched, fetched and decoded once.
+ */
+class STATUSNOTIFIERHOST_EXPORT StatusNotifierItemHost : public QObject
 {
     Q_OBJECT
 
@@ -26,6 +32,11 @@ public:
     const QList<QString> services() const;
     StatusNotifierItemSource *itemForService(const QString service);
 
+    /**
+     * The D-Bus calls made to each current item so far, by service and method name
+     */
+    QHash<QString, QHash<QString, int>> dbusCallCounts() const;
+
 Q_SIGNALS:
     void itemAdded(const QString &service);
     void itemRemoved(const QString &service);
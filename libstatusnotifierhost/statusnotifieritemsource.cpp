@@ -0,0 +1,683 @@
+/*
+    SPDX-FileCopyrightText: 2009 Marco Martin <notmart@gmail.com>
+    SPDX-FileCopyrightText: 2009 Matthieu Gallien <matthieu_gallien@yahoo.fr>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "statusnotifieritemsource.h"
+#include "statusnotifieritemservice.h"
+#include "systemtrayimage.h"
+#include "systemtraytypes.h"
+
+#include "statusnotifierhost_debug.h"
+
+#include <KIconEngine>
+#include <KIconLoader>
+#include <QApplication>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QDBusPendingReply>
+#include <QDBusVariant>
+#include <QDebug>
+#include <QIcon>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QVariantMap>
+
+#include <dbusmenuimporter.h>
+
+class PlasmaDBusMenuImporter : public DBusMenuImporter
+{
+public:
+    PlasmaDBusMenuImporter(const QString &service, const QString &path, KIconLoader *iconLoader, QObject *parent)
+        : DBusMenuImporter(service, path, parent)
+        , m_iconLoader(iconLoader)
+    {
+    }
+
+protected:
+    QIcon iconForName(const QString &name) override
+    {
+        return QIcon(new KIconEngine(name, m_iconLoader));
+    }
+
+private:
+    KIconLoader *m_iconLoader;
+};
+
+StatusNotifierItemSource::StatusNotifierItemSource(const QString &notifierItemId, QObject *parent)
+    : QObject(parent)
+    , m_customIconLoader(nullptr)
+    , m_menuImporter(nullptr)
+    , m_refreshing(false)
+    , m_needsReRefreshing(false)
+    , m_refreshAll(false)
+{
+    setObjectName(notifierItemId);
+    qDBusRegisterMetaType<KDbusImageStruct>();
+    qDBusRegisterMetaType<KDbusImageVector>();
+    qDBusRegisterMetaType<KDbusToolTipStruct>();
+
+    m_servicename = notifierItemId;
+
+    int slash = notifierItemId.indexOf('/');
+    if (slash == -1) {
+        qCWarning(STATUSNOTIFIERHOST) << "Invalid notifierItemId:" << notifierItemId;
+        m_valid = false;
+        m_statusNotifierItemInterface = nullptr;
+        return;
+    }
+    QString service = notifierItemId.left(slash);
+    QString path = notifierItemId.mid(slash);
+
+    m_statusNotifierItemInterface = new org::kde::StatusNotifierItem(service, path, QDBusConnection::sessionBus(), this);
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(10);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &StatusNotifierItemSource::performRefresh);
+
+    // In KiB, enough for the frames of an animated icon
+    m_iconCache.setMaxCost(2048);
+    // Four small sizes per icon, see cachedOverlayIcon()
+    m_overlaidIconCache.setMaxCost(256);
+
+    m_valid = !service.isEmpty() && m_statusNotifierItemInterface->isValid();
+    if (m_valid) {
+        // The icons depend on the icon theme path, which has no change signal of its own
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewTitle, this, [this] {
+            refreshProperties({QStringLiteral("Title")});
+        });
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewIcon, this, [this] {
+            refreshProperties({QStringLiteral("IconThemePath"), QStringLiteral("IconName"), QStringLiteral("IconPixmap")});
+        });
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewAttentionIcon, this, [this] {
+            refreshProperties({QStringLiteral("IconThemePath"),
+                               QStringLiteral("AttentionIconName"),
+                               QStringLiteral("AttentionIconPixmap"),
+                               QStringLiteral("AttentionMovieName")});
+        });
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewOverlayIcon, this, [this] {
+            refreshProperties({QStringLiteral("IconThemePath"), QStringLiteral("OverlayIconName"), QStringLiteral("OverlayIconPixmap")});
+        });
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewToolTip, this, [this] {
+            refreshProperties({QStringLiteral("IconThemePath"), QStringLiteral("ToolTip")});
+        });
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewStatus, this, &StatusNotifierItemSource::syncStatus);
+        connect(m_statusNotifierItemInterface, &OrgKdeStatusNotifierItem::NewMenu, this, &StatusNotifierItemSource::refreshMenu);
+        connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged, this, &StatusNotifierItemSource::reloadIcons);
+        refresh();
+    }
+}
+
+StatusNotifierItemSource::~StatusNotifierItemSource()
+{
+    delete m_statusNotifierItemInterface;
+}
+
+KIconLoader *StatusNotifierItemSource::iconLoader() const
+{
+    return m_customIconLoader ? m_customIconLoader : KIconLoader::global();
+}
+
+QIcon StatusNotifierItemSource::attentionIcon() const
+{
+    return m_attentionIcon;
+}
+
+QString StatusNotifierItemSource::attentionIconName() const
+{
+    return m_attentionIconName;
+}
+
+QString StatusNotifierItemSource::attentionMovieName() const
+{
+    return m_attentionMovieName;
+}
+
+QString StatusNotifierItemSource::category() const
+{
+    return m_category;
+}
+
+QIcon StatusNotifierItemSource::icon() const
+{
+    return m_icon;
+}
+
+QString StatusNotifierItemSource::iconName() const
+{
+    return m_iconName;
+}
+
+QString StatusNotifierItemSource::iconThemePath() const
+{
+    return m_iconThemePath;
+}
+
+QString StatusNotifierItemSource::id() const
+{
+    return m_id;
+}
+
+bool StatusNotifierItemSource::itemIsMenu() const
+{
+    return m_itemIsMenu;
+}
+
+QString StatusNotifierItemSource::overlayIconName() const
+{
+    return m_overlayIconName;
+}
+
+QString StatusNotifierItemSource::status() const
+{
+    return m_status;
+}
+
+QString StatusNotifierItemSource::title() const
+{
+    return m_title;
+}
+
+QVariant StatusNotifierItemSource::toolTipIcon() const
+{
+    return m_toolTipIcon;
+}
+
+QString StatusNotifierItemSource::toolTipSubTitle() const
+{
+    return m_toolTipSubTitle;
+}
+
+QString StatusNotifierItemSource::toolTipTitle() const
+{
+    return m_toolTipTitle;
+}
+
+QString StatusNotifierItemSource::windowId() const
+{
+    return m_windowId;
+}
+
+QHash<QString, int> StatusNotifierItemSource::dbusCallCounts() const
+{
+    return m_dbusCallCounts;
+}
+
+QDBusPendingCall StatusNotifierItemSource::asyncCall(const QDBusMessage &message)
+{
+    countCall(message.member());
+    return m_statusNotifierItemInterface->connection().asyncCall(message);
+}
+
+void StatusNotifierItemSource::countCall(const QString &method)
+{
+    ++m_dbusCallCounts[method];
+}
+
+Plasma::Service *StatusNotifierItemSource::createService()
+{
+    return new StatusNotifierItemService(this);
+}
+
+void StatusNotifierItemSource::syncStatus(const QString &status)
+{
+    m_status = status;
+    m_properties.insert(QStringLiteral("Status"), status);
+    Q_EMIT dataUpdated();
+}
+
+void StatusNotifierItemSource::refreshMenu()
+{
+    if (m_menuImporter) {
+        delete m_menuImporter;
+        m_menuImporter = nullptr;
+    }
+    refresh();
+}
+
+void StatusNotifierItemSource::refresh()
+{
+    m_refreshAll = true;
+
+    if (!m_refreshTimer.isActive()) {
+        m_refreshTimer.start();
+    }
+}
+
+void StatusNotifierItemSource::refreshProperties(const QStringList &properties)
+{
+    for (const QString &property : properties) {
+        m_pendingProperties.insert(property);
+    }
+
+    if (!m_refreshTimer.isActive()) {
+        m_refreshTimer.start();
+    }
+}
+
+void StatusNotifierItemSource::performRefresh()
+{
+    if (m_refreshing) {
+        m_needsReRefreshing = true;
+        return;
+    }
+
+    if (!m_refreshAll && m_pendingProperties.isEmpty()) {
+        return;
+    }
+
+    m_refreshing = true;
+
+    if (m_refreshAll) {
+        m_refreshAll = false;
+        m_pendingProperties.clear();
+
+        QDBusMessage message = QDBusMessage::createMethodCall(m_statusNotifierItemInterface->service(),
+                                                              m_statusNotifierItemInterface->path(),
+                                                              QStringLiteral("org.freedesktop.DBus.Properties"),
+                                                              QStringLiteral("GetAll"));
+
+        message << m_statusNotifierItemInterface->interface();
+        QDBusPendingCall call = asyncCall(message);
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, &StatusNotifierItemSource::refreshCallback);
+        return;
+    }
+
+    // Only what the change signals said changed, the pixmaps of the other icons can be large
+    const QStringList properties(m_pendingProperties.cbegin(), m_pendingProperties.cend());
+    m_pendingProperties.clear();
+    m_fetchedProperties.clear();
+    m_pendingPropertyCalls = properties.count();
+
+    for (const QString &property : properties) {
+        QDBusMessage message = QDBusMessage::createMethodCall(m_statusNotifierItemInterface->service(),
+                                                              m_statusNotifierItemInterface->path(),
+                                                              QStringLiteral("org.freedesktop.DBus.Properties"),
+                                                              QStringLiteral("Get"));
+
+        message << m_statusNotifierItemInterface->interface() << property;
+        QDBusPendingCall call = asyncCall(message);
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, property](QDBusPendingCallWatcher *call) {
+            QDBusPendingReply<QDBusVariant> reply = *call;
+            // Items need not implement every property, the missing ones are empty like with GetAll
+            m_fetchedProperties.insert(property, reply.isError() ? QVariant() : reply.value().variant());
+            call->deleteLater();
+
+            if (--m_pendingPropertyCalls == 0) {
+                updateProperties(m_fetchedProperties, false);
+                m_fetchedProperties.clear();
+                finishRefresh();
+            }
+        });
+    }
+}
+
+void StatusNotifierItemSource::finishRefresh()
+{
+    m_refreshing = false;
+
+    Q_EMIT dataUpdated();
+
+    // Whatever changed in the meantime
+    if (m_needsReRefreshing) {
+        m_needsReRefreshing = false;
+        performRefresh();
+    }
+}
+
+/**
+  \todo add a smart pointer to guard call and to automatically delete it at the end of the function
+  */
+void StatusNotifierItemSource::refreshCallback(QDBusPendingCallWatcher *call)
+{
+    QDBusPendingReply<QVariantMap> reply = *call;
+    if (reply.isError()) {
+        m_valid = false;
+    } else {
+        updateProperties(reply.argumentAt<0>(), true);
+    }
+
+    finishRefresh();
+    call->deleteLater();
+}
+
+void StatusNotifierItemSource::updateProperties(const QVariantMap &properties, bool all)
+{
+    if (all) {
+        m_properties = properties;
+    } else {
+        for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+            m_properties.insert(it.key(), it.value());
+        }
+    }
+
+    auto changed = [&properties, all](const QString &property) {
+        return all || properties.contains(property);
+    };
+
+    // IconThemePath (handle this one first, because it has an impact on
+    // others)
+    const bool iconThemePathChanged = changed(QStringLiteral("IconThemePath")) && updateIconThemePath(m_properties[QStringLiteral("IconThemePath")].toString());
+
+    m_category = m_properties[QStringLiteral("Category")].toString();
+    m_status = m_properties[QStringLiteral("Status")].toString();
+    m_title = m_properties[QStringLiteral("Title")].toString();
+    m_id = m_properties[QStringLiteral("Id")].toString();
+    m_windowId = m_properties[QStringLiteral("WindowId")].toString();
+    m_itemIsMenu = m_properties[QStringLiteral("ItemIsMenu")].toBool();
+
+    // Attention Movie
+    m_attentionMovieName = m_properties[QStringLiteral("AttentionMovieName")].toString();
+
+    // The overlay goes on both icons
+    const bool overlayChanged = all || iconThemePathChanged || changed(QStringLiteral("OverlayIconName")) || changed(QStringLiteral("OverlayIconPixmap"));
+    if (overlayChanged) {
+        updateOverlay();
+    }
+
+    if (overlayChanged || changed(QStringLiteral("IconName")) || changed(QStringLiteral("IconPixmap"))) {
+        std::tie(m_icon, m_iconName) = loadIcon(QStringLiteral("IconName"), QStringLiteral("IconPixmap"));
+    }
+    if (overlayChanged || changed(QStringLiteral("AttentionIconName")) || changed(QStringLiteral("AttentionIconPixmap"))) {
+        std::tie(m_attentionIcon, m_attentionIconName) = loadIcon(QStringLiteral("AttentionIconName"), QStringLiteral("AttentionIconPixmap"));
+    }
+
+    // ToolTip
+    if (iconThemePathChanged || changed(QStringLiteral("ToolTip"))) {
+        KDbusToolTipStruct toolTip;
+        m_properties[QStringLiteral("ToolTip")].value<QDBusArgument>() >> toolTip;
+        if (toolTip.title.isEmpty()) {
+            m_toolTipTitle = QString();
+            m_toolTipSubTitle = QString();
+            m_toolTipIcon = QString();
+        } else {
+            QIcon toolTipIcon;
+            if (toolTip.image.size() == 0) {
+                toolTipIcon = QIcon(new KIconEngine(toolTip.icon, iconLoader()));
+            } else {
+                size_t key;
+                toolTipIcon = cachedImageVectorToIcon(toolTip.image, &key);
+            }
+            m_toolTipTitle = toolTip.title;
+            m_toolTipSubTitle = toolTip.subTitle;
+            if (toolTipIcon.isNull() || toolTipIcon.availableSizes().isEmpty()) {
+                m_toolTipIcon = QString();
+            } else {
+                m_toolTipIcon = toolTipIcon;
+            }
+        }
+    }
+
+    // Menu
+    if (!m_menuImporter) {
+        QString menuObjectPath = m_properties[QStringLiteral("Menu")].value<QDBusObjectPath>().path();
+        if (!menuObjectPath.isEmpty()) {
+            if (menuObjectPath == QLatin1String("/NO_DBUSMENU")) {
+                // This is a hack to make it possible to disable DBusMenu in an
+                // application. The string "/NO_DBUSMENU" must be the same as in
+                // KStatusNotifierItem::setContextMenu().
+                qCWarning(STATUSNOTIFIERHOST) << "DBusMenu disabled for this application";
+            } else {
+                m_menuImporter = new PlasmaDBusMenuImporter(m_statusNotifierItemInterface->service(), menuObjectPath, iconLoader(), this);
+                connect(m_menuImporter, &PlasmaDBusMenuImporter::menuUpdated, this, [this](QMenu *menu) {
+                    if (menu == m_menuImporter->menu()) {
+                        contextMenuReady();
+                    }
+                });
+            }
+        }
+    }
+}
+
+bool StatusNotifierItemSource::updateIconThemePath(const QString &path)
+{
+    if (path == m_iconThemePath) {
+        return false;
+    }
+
+    if (!path.isEmpty()) {
+        if (!m_customIconLoader) {
+            m_customIconLoader = new KIconLoader(QString(), QStringList(), this);
+        }
+        // FIXME: If last part of path is not "icons", this won't work!
+        QString appName;
+        auto tokens = QStringView(path).split('/', Qt::SkipEmptyParts);
+        if (tokens.length() >= 3 && tokens.takeLast() == QLatin1String("icons"))
+            appName = tokens.takeLast().toString();
+
+        // icons may be either in the root directory of the passed path or in a appdir format
+        // i.e hicolor/32x32/iconname.png
+
+        m_customIconLoader->reconfigure(appName, QStringList(path));
+
+        // add app dir requires an app name, though this is completely unused in this context
+        m_customIconLoader->addAppDir(appName.size() ? appName : QStringLiteral("unused"), path);
+
+        connect(m_customIconLoader, &KIconLoader::iconChanged, this, [=] {
+            m_customIconLoader->reconfigure(appName, QStringList(path));
+            m_customIconLoader->addAppDir(appName.size() ? appName : QStringLiteral("unused"), path);
+        });
+    }
+    m_iconThemePath = path;
+
+    // The composed icons may come from the old path
+    m_overlaidIconCache.clear();
+    return true;
+}
+
+void StatusNotifierItemSource::updateOverlay()
+{
+    m_overlay = QIcon();
+    m_overlayNames.clear();
+    m_overlayKey = 0;
+    m_overlayIconName = QString();
+
+    const QString iconName = m_properties[QStringLiteral("OverlayIconName")].toString();
+    if (!iconName.isEmpty()) {
+        m_overlay = QIcon(new KIconEngine(iconName, iconLoader()));
+        if (!m_overlay.isNull()) {
+            m_overlayIconName = iconName;
+            m_overlayNames << iconName;
+            m_overlayKey = qHash(iconName);
+        }
+    }
+    if (m_overlay.isNull()) {
+        KDbusImageVector image;
+        m_properties[QStringLiteral("OverlayIconPixmap")].value<QDBusArgument>() >> image;
+        if (!image.isEmpty()) {
+            m_overlay = cachedImageVectorToIcon(image, &m_overlayKey);
+        }
+    }
+}
+
+void StatusNotifierItemSource::reloadIcons()
+{
+    m_overlaidIconCache.clear();
+    if (m_properties.isEmpty()) {
+        return;
+    }
+
+    updateOverlay();
+    std::tie(m_icon, m_iconName) = loadIcon(QStringLiteral("IconName"), QStringLiteral("IconPixmap"));
+    std::tie(m_attentionIcon, m_attentionIconName) = loadIcon(QStringLiteral("AttentionIconName"), QStringLiteral("AttentionIconPixmap"));
+    Q_EMIT dataUpdated();
+}
+
+std::tuple<QIcon, QString> StatusNotifierItemSource::loadIcon(const QString &iconKey, const QString &pixmapKey)
+{
+    const QString iconName = m_properties[iconKey].toString();
+    if (!iconName.isEmpty()) {
+        QIcon icon = QIcon(new KIconEngine(iconName, iconLoader(), m_overlayNames));
+        if (!icon.isNull()) {
+            if (!m_overlay.isNull() && m_overlayNames.isEmpty()) {
+                icon = cachedOverlayIcon(icon, qHash(iconName));
+            }
+            return {icon, iconName};
+        }
+    }
+    KDbusImageVector image;
+    m_properties[pixmapKey].value<QDBusArgument>() >> image;
+    if (!image.isEmpty()) {
+        size_t key;
+        QIcon icon = cachedImageVectorToIcon(image, &key);
+        if (!icon.isNull() && !m_overlay.isNull()) {
+            icon = cachedOverlayIcon(icon, key);
+        }
+        return {icon, QString()};
+    }
+    return {};
+}
+
+QIcon StatusNotifierItemSource::cachedImageVectorToIcon(const KDbusImageVector &vector, size_t *key)
+{
+    size_t hash = 0;
+    int bytes = 0;
+    for (const KDbusImageStruct &image : vector) {
+        hash = qHash(image.width, hash);
+        hash = qHash(image.height, hash);
+        hash = qHashBits(image.data.constData(), image.data.size(), hash);
+        bytes += image.data.size();
+    }
+    *key = hash;
+
+    if (QIcon *icon = m_iconCache.object(hash)) {
+        return *icon;
+    }
+
+    const QIcon icon = SystemTrayImage::toIcon(vector);
+    m_iconCache.insert(hash, new QIcon(icon), bytes / 1024 + 1);
+    return icon;
+}
+
+QIcon StatusNotifierItemSource::cachedOverlayIcon(const QIcon &icon, size_t iconKey)
+{
+    // Not the key of either icon on its own
+    const size_t key = qHash(m_overlayKey, qHash(iconKey, 1));
+
+    if (QIcon *overlaid = m_overlaidIconCache.object(key)) {
+        return *overlaid;
+    }
+
+    QIcon overlaid = icon;
+    overlayIcon(&overlaid, &m_overlay);
+    // Four small sizes at most, in KiB
+    m_overlaidIconCache.insert(key, new QIcon(overlaid), 16);
+    return overlaid;
+}
+
+void StatusNotifierItemSource::contextMenuReady()
+{
+    Q_EMIT contextMenuReady(m_menuImporter->menu());
+}
+
+void StatusNotifierItemSource::overlayIcon(QIcon *icon, QIcon *overlay)
+{
+    QIcon tmp;
+    QPixmap m_iconPixmap = icon->pixmap(KIconLoader::SizeSmall, KIconLoader::SizeSmall);
+
+    QPainter p(&m_iconPixmap);
+
+    const int size = KIconLoader::SizeSmall / 2;
+    p.drawPixmap(QRect(size, size, size, size), overlay->pixmap(size, size), QRect(0, 0, size, size));
+    p.end();
+    tmp.addPixmap(m_iconPixmap);
+
+    // if an m_icon exactly that size wasn't found don't add it to the vector
+    m_iconPixmap = icon->pixmap(KIconLoader::SizeSmallMedium, KIconLoader::SizeSmallMedium);
+    if (m_iconPixmap.width() == KIconLoader::SizeSmallMedium) {
+        const int size = KIconLoader::SizeSmall / 2;
+        QPainter p(&m_iconPixmap);
+        p.drawPixmap(QRect(m_iconPixmap.width() - size, m_iconPixmap.height() - size, size, size), overlay->pixmap(size, size), QRect(0, 0, size, size));
+        p.end();
+        tmp.addPixmap(m_iconPixmap);
+    }
+
+    m_iconPixmap = icon->pixmap(KIconLoader::SizeMedium, KIconLoader::SizeMedium);
+    if (m_iconPixmap.width() == KIconLoader::SizeMedium) {
+        const int size = KIconLoader::SizeSmall / 2;
+        QPainter p(&m_iconPixmap);
+        p.drawPixmap(QRect(m_iconPixmap.width() - size, m_iconPixmap.height() - size, size, size), overlay->pixmap(size, size), QRect(0, 0, size, size));
+        p.end();
+        tmp.addPixmap(m_iconPixmap);
+    }
+
+    m_iconPixmap = icon->pixmap(KIconLoader::SizeLarge, KIconLoader::SizeLarge);
+    if (m_iconPixmap.width() == KIconLoader::SizeLarge) {
+        const int size = KIconLoader::SizeSmall;
+        QPainter p(&m_iconPixmap);
+        p.drawPixmap(QRect(m_iconPixmap.width() - size, m_iconPixmap.height() - size, size, size), overlay->pixmap(size, size), QRect(0, 0, size, size));
+        p.end();
+        tmp.addPixmap(m_iconPixmap);
+    }
+
+    // We can't do 'm_icon->addPixmap()' because if 'm_icon' uses KIconEngine,
+    // it will ignore the added pixmaps. This is not a bug in KIconEngine,
+    // QIcon::addPixmap() doc says: "Custom m_icon engines are free to ignore
+    // additionally added pixmaps".
+    *icon = tmp;
+    // hopefully huge and enormous not necessary right now, since it's quite costly
+}
+
+void StatusNotifierItemSource::activate(int x, int y)
+{
+    if (m_statusNotifierItemInterface && m_statusNotifierItemInterface->isValid()) {
+        QDBusMessage message = QDBusMessage::createMethodCall(m_statusNotifierItemInterface->service(),
+                                                              m_statusNotifierItemInterface->path(),
+                                                              m_statusNotifierItemInterface->interface(),
+                                                              QStringLiteral("Activate"));
+
+        message << x << y;
+        QDBusPendingCall call = asyncCall(message);
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, &StatusNotifierItemSource::activateCallback);
+    }
+}
+
+void StatusNotifierItemSource::activateCallback(QDBusPendingCallWatcher *call)
+{
+    QDBusPendingReply<void> reply = *call;
+    Q_EMIT activateResult(!reply.isError());
+    call->deleteLater();
+}
+
+void StatusNotifierItemSource::secondaryActivate(int x, int y)
+{
+    if (m_statusNotifierItemInterface && m_statusNotifierItemInterface->isValid()) {
+        countCall(QStringLiteral("SecondaryActivate"));
+        m_statusNotifierItemInterface->call(QDBus::NoBlock, QStringLiteral("SecondaryActivate"), x, y);
+    }
+}
+
+void StatusNotifierItemSource::scroll(int delta, const QString &direction)
+{
+    if (m_statusNotifierItemInterface && m_statusNotifierItemInterface->isValid()) {
+        countCall(QStringLiteral("Scroll"));
+        m_statusNotifierItemInterface->call(QDBus::NoBlock, QStringLiteral("Scroll"), delta, direction);
+    }
+}
+
+void StatusNotifierItemSource::contextMenu(int x, int y)
+{
+    if (m_menuImporter) {
+        m_menuImporter->updateMenu();
+    } else {
+        qCWarning(STATUSNOTIFIERHOST) << "Could not find DBusMenu interface, falling back to calling ContextMenu()";
+        if (m_statusNotifierItemInterface && m_statusNotifierItemInterface->isValid()) {
+            countCall(QStringLiteral("ContextMenu"));
+            m_statusNotifierItemInterface->call(QDBus::NoBlock, QStringLiteral("ContextMenu"), x, y);
+        }
+    }
+}
+
+void StatusNotifierItemSource::provideXdgActivationToken(const QString &token)
+{
+    if (m_statusNotifierItemInterface && m_statusNotifierItemInterface->isValid()) {
+        countCall(QStringLiteral("ProvideXdgActivationToken"));
+        m_statusNotifierItemInterface->ProvideXdgActivationToken(token);
+    }
+}
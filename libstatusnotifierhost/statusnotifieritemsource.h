@@ -8,16 +8,22 @@
 #pragma once
 
 #include <Plasma/DataContainer>
+#include <QCache>
 #include <QDBusPendingCallWatcher>
 #include <QMenu>
+#include <QSet>
 #include <QString>
+#include <QVariantMap>
 
+#include <tuple>
+
+#include "statusnotifierhost_export.h"
 #include "statusnotifieritem_interface.h"
 
 class DBusMenuImporter;
 class KIconLoader;
 
-class StatusNotifierItemSource : public QObject
+class STATUSNOTIFIERHOST_EXPORT StatusNotifierItemSource : public QObject
 {
     Q_OBJECT
 
@@ -49,6 +55,11 @@ public:
     QString toolTipTitle() const;
     QString windowId() const;
 
+    /**
+     * The D-Bus calls made to the item so far, by method name
+     */
+    QHash<QString, int> dbusCallCounts() const;
+
 Q_SIGNALS:
     void contextMenuReady(QMenu *menu);
     void activateResult(bool success);
@@ -64,8 +75,21 @@ private Q_SLOTS:
     void activateCallback(QDBusPendingCallWatcher *);
 
 private:
-    QPixmap KDbusImageStructToPixmap(const KDbusImageStruct &image) const;
-    QIcon imageVectorToPixmap(const KDbusImageVector &vector) const;
+    // Fetches only @p properties on the next refresh, unless everything is to be fetched anyway
+    void refreshProperties(const QStringList &properties);
+    QDBusPendingCall asyncCall(const QDBusMessage &message);
+    void countCall(const QString &method);
+    void finishRefresh();
+    // Takes over the fetched properties, @p all if they are all of them
+    void updateProperties(const QVariantMap &properties, bool all);
+    bool updateIconThemePath(const QString &path);
+    void updateOverlay();
+    // Composes the icons again, for when the icons they were made of may have changed
+    void reloadIcons();
+    std::tuple<QIcon, QString> loadIcon(const QString &iconKey, const QString &pixmapKey);
+    QIcon cachedImageVectorToIcon(const KDbusImageVector &vector, size_t *key);
+    QIcon cachedOverlayIcon(const QIcon &icon, size_t iconKey);
+
     void overlayIcon(QIcon *icon, QIcon *overlay);
     KIconLoader *iconLoader() const;
 
@@ -77,6 +101,21 @@ private:
     org::kde::StatusNotifierItem *m_statusNotifierItemInterface;
     bool m_refreshing : 1;
     bool m_needsReRefreshing : 1;
+    bool m_refreshAll : 1;
+    QSet<QString> m_pendingProperties;
+    QVariantMap m_fetchedProperties;
+    int m_pendingPropertyCalls = 0;
+    // The last known value of every property
+    QVariantMap m_properties;
+
+    // Icons decoded from pixmap data, keyed by the hash of the data
+    QCache<size_t, QIcon> m_iconCache;
+    // Icons with the overlay painted on them, keyed by the hash of both; they depend on the icon theme
+    QCache<size_t, QIcon> m_overlaidIconCache;
+    QIcon m_overlay;
+    QStringList m_overlayNames;
+    // Tells the overlays apart, whether they come from a name or from pixmap data
+    size_t m_overlayKey = 0;
 
     QIcon m_attentionIcon;
     QString m_attentionIconName;
@@ -94,4 +133,6 @@ private:
     QString m_toolTipSubTitle;
     QString m_toolTipTitle;
     QString m_windowId;
+
+    QHash<QString, int> m_dbusCallCounts;
 };
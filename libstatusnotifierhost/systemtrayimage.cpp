@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "systemtrayimage.h"
+
+#include <QPixmap>
+#include <QtEndian>
+
+namespace SystemTrayImage
+{
+static void argbFromBigEndianScalar(const uchar *source, quint32 *destination, int count)
+{
+    qFromBigEndian<quint32>(source, count, destination);
+}
+
+// On big endian machines there is nothing to swap, all the kernels copy
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+
+#if defined(SIMD_SSE2)
+static void argbFromBigEndianSse2(const uchar *source, quint32 *destination, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4));
+        // Swap the bytes of the 16 bit halves, then the halves
+        pixels = _mm_or_si128(_mm_slli_epi16(pixels, 8), _mm_srli_epi16(pixels, 8));
+        pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(2, 3, 0, 1));
+        pixels = _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), pixels);
+    }
+    argbFromBigEndianScalar(source + i * 4, destination + i, count - i);
+}
+#endif
+
+#if defined(SIMD_AVX2)
+SIMD_TARGET_AVX2 static void argbFromBigEndianAvx2(const uchar *source, quint32 *destination, int count)
+{
+    const __m256i reverse = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, //
+                                             3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(pixels, reverse));
+    }
+    argbFromBigEndianScalar(source + i * 4, destination + i, count - i);
+}
+#endif
+
+#if defined(SIMD_NEON)
+static void argbFromBigEndianNeon(const uchar *source, quint32 *destination, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint8x16_t pixels = vld1q_u8(source + i * 4);
+        vst1q_u8(reinterpret_cast<uint8_t *>(destination + i), vrev32q_u8(pixels));
+    }
+    argbFromBigEndianScalar(source + i * 4, destination + i, count - i);
+}
+#endif
+
+#endif
+
+void argbFromBigEndian(const uchar *source, quint32 *destination, int count, Simd::Kernel kernel)
+{
+    Q_ASSERT(Simd::isSupported(kernel));
+    switch (kernel) {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#if defined(SIMD_SSE2)
+    case Simd::Kernel::Sse2:
+        argbFromBigEndianSse2(source, destination, count);
+        return;
+#endif
+#if defined(SIMD_AVX2)
+    case Simd::Kernel::Avx2:
+        argbFromBigEndianAvx2(source, destination, count);
+        return;
+#endif
+#if defined(SIMD_NEON)
+    case Simd::Kernel::Neon:
+        argbFromBigEndianNeon(source, destination, count);
+        return;
+#endif
+#endif
+    default:
+        argbFromBigEndianScalar(source, destination, count);
+        return;
+    }
+}
+
+QImage toImage(const KDbusImageStruct &image)
+{
+    if (image.width <= 0 || image.height <= 0) {
+        return QImage();
+    }
+
+    const qint64 pixelCount = qint64(image.width) * image.height;
+    if (image.data.size() < pixelCount * 4) {
+        return QImage();
+    }
+
+    QImage result(image.width, image.height, QImage::Format_ARGB32);
+    if (result.isNull()) {
+        return QImage();
+    }
+
+    // The lines of 32 bit images are not padded, convert all of them at once
+    argbFromBigEndian(reinterpret_cast<const uchar *>(image.data.constData()), reinterpret_cast<quint32 *>(result.bits()), static_cast<int>(pixelCount));
+    return result;
+}
+
+QIcon toIcon(const KDbusImageVector &vector)
+{
+    QIcon icon;
+
+    for (const KDbusImageStruct &image : vector) {
+        const QImage decoded = toImage(image);
+        if (!decoded.isNull()) {
+            icon.addPixmap(QPixmap::fromImage(decoded));
+        }
+    }
+
+    return icon;
+}
+}
@@ -0,0 +1,41 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QIcon>
+#include <QImage>
+
+#include "../simd_dispatch.h"
+#include "statusnotifierhost_export.h"
+#include "systemtraytypedefs.h"
+
+/**
+ * Decoding of the pixmaps StatusNotifierItems send, shared by the system tray
+ * applet and the statusnotifieritem dataengine.
+ */
+namespace SystemTrayImage
+{
+/**
+ * The image in @p image, whose ARGB32 pixels are in network byte order.
+ *
+ * The pixels are converted into a new image, @p image is left untouched, so the same
+ * data can be decoded any number of times. Returns a null image if there is not
+ * enough data for the size.
+ */
+STATUSNOTIFIERHOST_EXPORT QImage toImage(const KDbusImageStruct &image);
+
+/**
+ * An icon with all the sizes in @p vector
+ */
+STATUSNOTIFIERHOST_EXPORT QIcon toIcon(const KDbusImageVector &vector);
+
+/**
+ * Converts @p count big endian ARGB32 pixels from @p source to native ones in @p destination.
+ * @p kernel has to be one Simd::isSupported() accepts
+ */
+STATUSNOTIFIERHOST_EXPORT void argbFromBigEndian(const uchar *source, quint32 *destination, int count, Simd::Kernel kernel = Simd::best());
+}
@@ -13,6 +13,7 @@
 #include <QDir>
 #include <QIcon>
 #include <QTimer>
+#include <QtConcurrent>
 
 #include <KApplicationTrader>
 #include <KLocalizedString>
@@ -21,11 +22,13 @@
 #include <set>
 
 #include "debug.h"
+#include "../matchtimer.h"
 
 K_PLUGIN_CLASS_WITH_JSON(InstallerRunner, "plasma-runner-appstream.json")
 
 InstallerRunner::InstallerRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
     : Plasma::AbstractRunner(parent, metaData, args)
+    , m_resultCache(50)
 {
     setObjectName(QStringLiteral("Installation Suggestions"));
     // We want to give the other runners time to check if there are matching applications already installed
@@ -33,10 +36,17 @@ InstallerRunner::InstallerRunner(QObject *parent, const KPluginMetaData &metaDat
 
     addSyntax(Plasma::RunnerSyntax(":q:", i18n("Looks for non-installed components according to :q:")));
     setMinLetterCount(3);
+
+    // Parsing the metadata pool takes seconds, don't let the first query of the session pay for it
+    m_poolFuture = QtConcurrent::run([this] {
+        loadPool();
+    });
 }
 
 InstallerRunner::~InstallerRunner()
 {
+    // The loader thread uses m_db, it must not outlive us
+    m_poolFuture.waitForFinished();
 }
 
 static QIcon componentIcon(const AppStream::Component &comp)
@@ -70,6 +80,7 @@ static QIcon componentIcon(const AppStream::Component &comp)
 
 void InstallerRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     // Give the other runners a bit of time to produce results
     QEventLoop loop;
     QTimer::singleShot(200, &loop, [&loop]() {
@@ -145,22 +156,33 @@ void InstallerRunner::run(const Plasma::RunnerContext & /*context*/, const Plasm
         qCWarning(RUNNER_APPSTREAM) << "couldn't open" << appstreamUrl;
 }
 
+void InstallerRunner::loadPool()
+{
+    QString error;
+    if (!m_db.load(&error)) {
+        qCWarning(RUNNER_APPSTREAM) << "Had errors when loading AppStream metadata pool" << error;
+    }
+
+    // Even a partially loaded pool is worth searching
+    m_poolReady = true;
+    Q_EMIT poolReady();
+}
+
 QList<AppStream::Component> InstallerRunner::findComponentsByString(const QString &query)
 {
+    if (!m_poolReady) {
+        qCDebug(RUNNER_APPSTREAM) << "AppStream metadata pool is still loading, skipping query" << query;
+        return {};
+    }
+
     QMutexLocker locker(&m_appstreamMutex);
-    QString error;
-    static bool warnedOnce = false;
-    static bool opened = m_db.load(&error);
-    if (!opened) {
-        if (warnedOnce) {
-            qCDebug(RUNNER_APPSTREAM) << "Had errors when loading AppStream metadata pool" << error;
-        } else {
-            qCWarning(RUNNER_APPSTREAM) << "Had errors when loading AppStream metadata pool" << error;
-            warnedOnce = true;
-        }
+    if (const auto cached = m_resultCache.object(query)) {
+        return *cached;
     }
 
-    return m_db.search(query);
+    const QList<AppStream::Component> components = m_db.search(query);
+    m_resultCache.insert(query, new QList<AppStream::Component>(components));
+    return components;
 }
 
 #include "appstreamrunner.moc"
@@ -8,8 +8,12 @@
 
 #include <AppStreamQt/pool.h>
 #include <KRunner/AbstractRunner>
+#include <QCache>
+#include <QFuture>
 #include <QMutex>
 
+#include <atomic>
+
 class InstallerRunner : public Plasma::AbstractRunner
 {
     Q_OBJECT
@@ -21,9 +25,20 @@ public:
     void match(Plasma::RunnerContext &context) override;
     void run(const Plasma::RunnerContext &context, const Plasma::QueryMatch &action) override;
 
+Q_SIGNALS:
+    /**
+     * Emitted from the loader thread once the AppStream pool can be queried
+     */
+    void poolReady();
+
 private:
+    void loadPool();
     QList<AppStream::Component> findComponentsByString(const QString &query);
 
     AppStream::Pool m_db;
+    QFuture<void> m_poolFuture;
+    std::atomic<bool> m_poolReady = false;
+    // Guards m_db searches and m_resultCache once the pool is ready
     QMutex m_appstreamMutex;
+    QCache<QString, QList<AppStream::Component>> m_resultCache;
 };
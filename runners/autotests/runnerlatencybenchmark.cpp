@@ -0,0 +1,243 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTextStream>
+
+#include <KConfigGroup>
+#include <KPluginMetaData>
+#include <KRunner/AbstractRunner>
+#include <KRunner/RunnerContext>
+#include <KRunner/RunnerManager>
+#include <KSharedConfig>
+#include <KSycoca>
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+
+/**
+ * Replays a corpus of queries one keystroke at a time against every runner plugin in the build tree
+ * and reports the p50/p99 latency of their match() calls.
+ *
+ * The environment is synthetic: a throwaway home with PLASMA_RUNNER_BENCHMARK_APPS (default 500)
+ * generated .desktop files and the firefox bookmark fixtures of the bookmarks runner.
+ * PLASMA_RUNNER_BENCHMARK_RUNNERS optionally restricts the run to a comma separated list of plugin ids.
+ *
+ * It is not part of ctest, run the runnerlatencybenchmark executable of the build tree by hand.
+ */
+class RunnerLatencyBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkRunner_data();
+    void benchmarkRunner();
+
+private:
+    static bool copyRecursively(const QString &source, const QString &target);
+    static bool writeDesktopFiles(const QString &appsPath, int count);
+    static double percentile(const QVector<qint64> &sortedSamples, double fraction);
+
+    QTemporaryDir m_home;
+    QStringList m_queries;
+    Plasma::RunnerManager *m_manager = nullptr;
+    QHash<QString, KPluginMetaData> m_plugins;
+};
+
+void RunnerLatencyBenchmark::initTestCase()
+{
+    QVERIFY(m_home.isValid());
+    // Everything derived from the home directory, including the test mode locations, ends up in our temporary dir
+    qputenv("HOME", m_home.path().toLocal8Bit());
+    QStandardPaths::setTestModeEnabled(true);
+    setlocale(LC_ALL, "C.utf8");
+    QVERIFY(setenv("XDG_CURRENT_DESKTOP", "KDE", 1) == 0);
+
+    bool ok = false;
+    int appCount = qEnvironmentVariableIntValue("PLASMA_RUNNER_BENCHMARK_APPS", &ok);
+    if (!ok) {
+        appCount = 500;
+    }
+    const QString appsPath = QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation);
+    QVERIFY(QDir().mkpath(appsPath));
+    QVERIFY(writeDesktopFiles(appsPath, appCount));
+    KSycoca::self()->ensureCacheValid();
+
+    QVERIFY(copyRecursively(QStringLiteral(BOOKMARKS_FIXTURE_DIR), m_home.path() + QStringLiteral("/.mozilla/firefox")));
+    KConfigGroup general(KSharedConfig::openConfig(QStringLiteral("kdeglobals")), QStringLiteral("General"));
+    general.writePathEntry(QStringLiteral("BrowserApplication"), QStringLiteral("firefox"));
+    general.sync();
+
+    QFile corpus(QFINDTESTDATA("querycorpus.txt"));
+    QVERIFY(corpus.open(QIODevice::ReadOnly | QIODevice::Text));
+    QTextStream stream(&corpus);
+    while (!stream.atEnd()) {
+        const QString query = stream.readLine().trimmed();
+        if (!query.isEmpty()) {
+            m_queries << query;
+        }
+    }
+    QVERIFY(!m_queries.isEmpty());
+
+    const QStringList wanted = qEnvironmentVariable("PLASMA_RUNNER_BENCHMARK_RUNNERS").split(QLatin1Char(','), Qt::SkipEmptyParts);
+    const QVector<KPluginMetaData> plugins = KPluginMetaData::findPlugins(QStringLiteral(RUNNER_PLUGIN_DIR));
+    for (const KPluginMetaData &plugin : plugins) {
+        if (!wanted.isEmpty() && !wanted.contains(plugin.pluginId())) {
+            continue;
+        }
+        // The appstream runner deliberately waits for the other runners before doing anything
+        if (wanted.isEmpty() && plugin.pluginId() == QLatin1String("krunner_appstream")) {
+            continue;
+        }
+        m_plugins.insert(plugin.pluginId(), plugin);
+    }
+    QVERIFY2(!m_plugins.isEmpty(), "No runner plugins found in " RUNNER_PLUGIN_DIR);
+
+    m_manager = new Plasma::RunnerManager(this);
+}
+
+void RunnerLatencyBenchmark::cleanupTestCase()
+{
+    delete m_manager;
+    m_manager = nullptr;
+}
+
+void RunnerLatencyBenchmark::benchmarkRunner_data()
+{
+    QTest::addColumn<QString>("pluginId");
+
+    QStringList pluginIds = m_plugins.keys();
+    std::sort(pluginIds.begin(), pluginIds.end());
+    for (const QString &pluginId : std::as_const(pluginIds)) {
+        QTest::newRow(qPrintable(pluginId)) << pluginId;
+    }
+}
+
+void RunnerLatencyBenchmark::benchmarkRunner()
+{
+    QFETCH(QString, pluginId);
+
+    Plasma::AbstractRunner *runner = m_manager->loadRunner(m_plugins.value(pluginId));
+    QVERIFY(runner);
+
+    Q_EMIT runner->prepare();
+
+    QVector<qint64> samples;
+    for (const QString &query : std::as_const(m_queries)) {
+        // One match per keystroke, like typing into KRunner does
+        for (int length = 1; length <= query.size(); ++length) {
+            const QString term = query.left(length);
+            // Mirror the RunnerManager which does not bother runners with too short queries
+            if (term.size() < runner->minLetterCount()) {
+                continue;
+            }
+
+            Plasma::RunnerContext context;
+            context.setQuery(term);
+
+            QElapsedTimer timer;
+            timer.start();
+            runner->match(context);
+            samples << timer.nsecsElapsed();
+        }
+    }
+
+    Q_EMIT runner->teardown();
+
+    QVERIFY(!samples.isEmpty());
+    std::sort(samples.begin(), samples.end());
+
+    qInfo().noquote() << QStringLiteral("%1: %2 matches, p50 %3 ms, p99 %4 ms, max %5 ms")
+                             .arg(pluginId)
+                             .arg(samples.size())
+                             .arg(percentile(samples, 0.50) / 1e6, 0, 'f', 3)
+                             .arg(percentile(samples, 0.99) / 1e6, 0, 'f', 3)
+                             .arg(samples.last() / 1e6, 0, 'f', 3);
+}
+
+bool RunnerLatencyBenchmark::copyRecursively(const QString &source, const QString &target)
+{
+    const QDir sourceDir(source);
+    QDirIterator it(source, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString sourceFile = it.next();
+        const QString targetFile = target + QLatin1Char('/') + sourceDir.relativeFilePath(sourceFile);
+        if (!QDir().mkpath(QFileInfo(targetFile).absolutePath()) || !QFile::copy(sourceFile, targetFile)) {
+            qWarning() << "can't copy" << sourceFile << "=>" << targetFile;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RunnerLatencyBenchmark::writeDesktopFiles(const QString &appsPath, int count)
+{
+    static const QStringList prefixes = {QStringLiteral("Photo"),
+                                         QStringLiteral("Text"),
+                                         QStringLiteral("Sound"),
+                                         QStringLiteral("Video"),
+                                         QStringLiteral("Office"),
+                                         QStringLiteral("Network"),
+                                         QStringLiteral("Code"),
+                                         QStringLiteral("Game"),
+                                         QStringLiteral("Disk"),
+                                         QStringLiteral("Mail")};
+    static const QStringList suffixes = {QStringLiteral("Editor"),
+                                         QStringLiteral("Viewer"),
+                                         QStringLiteral("Manager"),
+                                         QStringLiteral("Player"),
+                                         QStringLiteral("Studio"),
+                                         QStringLiteral("Tool"),
+                                         QStringLiteral("Browser"),
+                                         QStringLiteral("Monitor")};
+
+    for (int i = 0; i < count; ++i) {
+        const QString prefix = prefixes.at(i % prefixes.size());
+        const QString suffix = suffixes.at((i / prefixes.size()) % suffixes.size());
+        const QString name = QStringLiteral("%1 %2 %3").arg(prefix, suffix).arg(i);
+
+        QFile file(QStringLiteral("%1/org.kde.benchmark%2.desktop").arg(appsPath).arg(i));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning() << "can't write" << file.fileName();
+            return false;
+        }
+        QTextStream stream(&file);
+        stream << "[Desktop Entry]\n"
+               << "Type=Application\n"
+               << "Name=" << name << '\n'
+               << "GenericName=" << prefix << ' ' << suffix << '\n'
+               << "Comment=Synthetic " << prefix.toLower() << " application for benchmarking\n"
+               << "Keywords=" << prefix.toLower() << ';' << suffix.toLower() << ";benchmark;\n"
+               << "Exec=benchmark-app-" << i << " %U\n"
+               << "Icon=applications-other\n"
+               << "Categories=Utility;\n";
+    }
+    return true;
+}
+
+double RunnerLatencyBenchmark::percentile(const QVector<qint64> &sortedSamples, double fraction)
+{
+    // Nearest-rank percentile
+    const int rank = std::max(1, int(std::ceil(fraction * sortedSamples.size())));
+    return sortedSamples.at(rank - 1);
+}
+
+QTEST_MAIN(RunnerLatencyBenchmark)
+
+#include "runnerlatencybenchmark.moc"
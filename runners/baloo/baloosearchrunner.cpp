@@ -25,6 +25,7 @@
 #include <KNotificationJobUiDelegate>
 #include <KShell>
 
+#include "../matchtimer.h"
 #include "krunner1adaptor.h"
 
 static const QString s_openParentDirId = QStringLiteral("openParentDir");
@@ -65,6 +66,7 @@ RemoteActions SearchRunner::Actions()
 
 RemoteMatches SearchRunner::Match(const QString &searchTerm)
 {
+    const MatchTimer timer(QStringLiteral("baloosearch"), searchTerm);
     Baloo::IndexerConfig config;
     if (!config.fileIndexingEnabled()) {
         sendErrorReply(QDBusError::ErrorType::NotSupported);
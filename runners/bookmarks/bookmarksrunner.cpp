@@ -23,6 +23,7 @@
 #include "bookmarkmatch.h"
 #include "bookmarksrunner_defs.h"
 #include "browserfactory.h"
+#include "../matchtimer.h"
 
 K_PLUGIN_CLASS_WITH_JSON(BookmarksRunner, "plasma-runner-bookmarks.json")
 
@@ -55,6 +56,7 @@ void BookmarksRunner::prep()
 
 void BookmarksRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString term = context.query();
     bool allBookmarks = term.compare(i18nc("list of all konqueror bookmarks", "bookmarks"), Qt::CaseInsensitive) == 0;
 
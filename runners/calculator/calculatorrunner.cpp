@@ -20,6 +20,8 @@
 #include <KLocalizedString>
 #include <krunner/querymatch.h>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(CalculatorRunner, "plasma-runner-calculator.json")
 
 static QMutex s_initMutex;
@@ -58,6 +60,7 @@ void CalculatorRunner::userFriendlySubstitutions(QString &cmd)
 
 void CalculatorRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString term = context.query();
     QString cmd = term;
 
@@ -9,6 +9,8 @@
 #include <KLocalizedString>
 #include <KPluginMetaData>
 
+#include "../matchtimer.h"
+
 HelpRunner::HelpRunner(QObject *parent, const KPluginMetaData &pluginMetaData, const QVariantList &args)
     : AbstractRunner(parent, pluginMetaData, args)
 {
@@ -20,6 +22,7 @@ HelpRunner::HelpRunner(QObject *parent, const KPluginMetaData &pluginMetaData, c
 
 void HelpRunner::match(RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString sanatizedQuery = context.query().remove(matchRegex());
     auto runners = m_manager->runners();
     for (auto it = runners.begin(); it != runners.end();) {
@@ -19,6 +19,8 @@
 #include <processcore/process.h>
 #include <processcore/processes.h>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(KillRunner, "plasma-runner-kill.json")
 
 KillRunner::KillRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -88,6 +90,7 @@ void KillRunner::cleanup()
 
 void KillRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     QString term = context.query();
     m_prepLock.lockForRead();
     if (!m_processes) {
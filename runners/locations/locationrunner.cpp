@@ -22,6 +22,8 @@
 #include <KUriFilter>
 #include <QDebug>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(LocationsRunner, "plasma-runner-locations.json")
 
 LocationsRunner::LocationsRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -39,6 +41,7 @@ LocationsRunner::~LocationsRunner()
 
 void LocationsRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     QString term = context.query();
     // If we have a query with an executable and optionally arguments, BUG: 433053
     const QStringList split = KShell::splitArgs(term);
@@ -0,0 +1,49 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "matchtimer_debug.h"
+
+/**
+ * Opt-in tracing of how long a runner spends in a single match call.
+ *
+ * Disabled by default, enable with
+ * QT_LOGGING_RULES="org.kde.plasma.runner.timing.debug=true"
+ *
+ * Logs the time between its construction and destruction to RUNNER_TIMING.
+ * Put one at the top of a match implementation.
+ */
+class MatchTimer
+{
+public:
+    MatchTimer(const QString &runnerId, const QString &query)
+        : m_runnerId(runnerId)
+        , m_query(query)
+    {
+        if (RUNNER_TIMING().isDebugEnabled()) {
+            m_timer.start();
+        }
+    }
+
+    ~MatchTimer()
+    {
+        if (m_timer.isValid()) {
+            qCDebug(RUNNER_TIMING).nospace() << m_runnerId << " matched " << m_query << " in " << m_timer.nsecsElapsed() / 1000 << "µs";
+        }
+    }
+
+    MatchTimer(const MatchTimer &) = delete;
+    MatchTimer &operator=(const MatchTimer &) = delete;
+
+private:
+    const QString m_runnerId;
+    const QString m_query;
+    QElapsedTimer m_timer;
+};
@@ -19,6 +19,8 @@
 #include <KLocalizedString>
 #include <KNotificationJobUiDelegate>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(PlacesRunner, "plasma-runner-places.json")
 
 // Q_DECLARE_METATYPE(Plasma::RunnerContext)
@@ -42,6 +44,7 @@ PlacesRunner::~PlacesRunner()
 
 void PlacesRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     if (QThread::currentThread() == QCoreApplication::instance()->thread()) {
         // from the main thread
         // qDebug() << "calling";
@@ -21,6 +21,8 @@
 
 #include <cmath>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(PowerDevilRunner, "plasma-runner-powerdevil.json")
 
 PowerDevilRunner::PowerDevilRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -83,6 +85,7 @@ enum SleepState { StandbyState = 1, SuspendState = 2, HibernateState = 4, Hybrid
 
 void PowerDevilRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString term = context.query();
     Plasma::QueryMatch::Type type = Plasma::QueryMatch::ExactMatch;
     QList<Plasma::QueryMatch> matches;
@@ -20,9 +20,14 @@
 #include <KActivities/Stats/ResultModel>
 #include <KActivities/Stats/Terms>
 
+#include "../matchtimer.h"
+
 using namespace KActivities::Stats;
 using namespace KActivities::Stats::Terms;
 
+static const int s_snapshotSize = 1000;
+static const int s_maxMatches = 20;
+
 K_PLUGIN_CLASS_WITH_JSON(RecentDocuments, "plasma-runner-recentdocuments.json")
 
 RecentDocuments::RecentDocuments(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -34,39 +39,90 @@ RecentDocuments::RecentDocuments(QObject *parent, const KPluginMetaData &metaDat
 
     m_actions = {new QAction(QIcon::fromTheme(QStringLiteral("document-open-folder")), i18n("Open Containing Folder"), this)};
     setMinLetterCount(3);
+
+    // Query the activity manager once and let the model follow its change notifications,
+    // the individual queries only filter this snapshot in memory
+    // clang-format off
+    const auto query = UsedResources
+            | Activity::current()
+            | Order::RecentlyUsedFirst
+            | Agent::any()
+            | Limit(s_snapshotSize);
+    // clang-format on
+    m_resultModel = new ResultModel(query, this);
+
+    m_snapshotTimer.setSingleShot(true);
+    m_snapshotTimer.setInterval(0);
+    connect(&m_snapshotTimer, &QTimer::timeout, this, &RecentDocuments::updateSnapshot);
+
+    auto scheduleUpdate = [this] {
+        m_snapshotTimer.start();
+    };
+    connect(m_resultModel, &QAbstractItemModel::modelReset, this, scheduleUpdate);
+    connect(m_resultModel, &QAbstractItemModel::rowsInserted, this, scheduleUpdate);
+    connect(m_resultModel, &QAbstractItemModel::rowsRemoved, this, scheduleUpdate);
+    connect(m_resultModel, &QAbstractItemModel::rowsMoved, this, scheduleUpdate);
+    connect(m_resultModel, &QAbstractItemModel::dataChanged, this, scheduleUpdate);
+    connect(m_resultModel, &QAbstractItemModel::layoutChanged, this, scheduleUpdate);
+
+    updateSnapshot();
 }
 
 RecentDocuments::~RecentDocuments()
 {
 }
 
+void RecentDocuments::updateSnapshot()
+{
+    while (m_resultModel->canFetchMore(QModelIndex())) {
+        m_resultModel->fetchMore(QModelIndex());
+    }
+
+    QVector<RecentDocument> snapshot;
+    snapshot.reserve(m_resultModel->rowCount());
+    for (int i = 0; i < m_resultModel->rowCount(); ++i) {
+        const auto index = m_resultModel->index(i, 0);
+        const QString resource = m_resultModel->data(index, ResultModel::ResourceRole).toString();
+        const auto url = QUrl::fromUserInput(resource,
+                                             QString(),
+                                             // Resources without a scheme are local paths
+                                             QUrl::AssumeLocalFile);
+        snapshot.append({resource, url, m_resultModel->data(index, ResultModel::TitleRole).toString()});
+    }
+
+    QWriteLocker locker(&m_snapshotLock);
+    m_snapshot = snapshot;
+}
+
 void RecentDocuments::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     if (!context.isValid()) {
         return;
     }
 
-    // clang-format off
     const QString term = context.query();
-    auto query = UsedResources
-            | Activity::current()
-            | Order::RecentlyUsedFirst
-            | Agent::any()
-            // we search only on file name, as KActivity does not support better options
-            | Url("/*/" + term + "*")
-            | Limit(20);
-    // clang-format on
-
-    const auto result = new ResultModel(query);
+    // KActivities used to glob the resource against "/*/term*": a local path with a component
+    // other than the root one starting with the term, case sensitively
+    const QString needle = QLatin1Char('/') + term;
+
+    QVector<RecentDocument> snapshot;
+    {
+        QReadLocker locker(&m_snapshotLock);
+        snapshot = m_snapshot;
+    }
 
-    for (int i = 0; i < result->rowCount(); ++i) {
-        const auto index = result->index(i, 0);
+    int count = 0;
+    for (const RecentDocument &document : std::as_const(snapshot)) {
+        if (!document.resource.startsWith(QLatin1Char('/')) || document.resource.indexOf(needle, 1) == -1) {
+            continue;
+        }
+        if (++count > s_maxMatches) {
+            break;
+        }
 
-        const auto url = QUrl::fromUserInput(result->data(index, ResultModel::ResourceRole).toString(),
-                                             QString(),
-                                             // We can assume local file thanks to the request Url
-                                             QUrl::AssumeLocalFile);
-        const auto name = result->data(index, ResultModel::TitleRole).toString();
+        const QUrl &url = document.url;
+        const QString &name = document.title;
 
         Plasma::QueryMatch match(this);
 
@@ -10,6 +10,18 @@
 
 #include <QAction>
 #include <QIcon>
+#include <QReadWriteLock>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+namespace KActivities
+{
+namespace Stats
+{
+class ResultModel;
+}
+}
 
 class RecentDocuments : public Plasma::AbstractRunner
 {
@@ -23,5 +35,21 @@ public:
     void run(const Plasma::RunnerContext &context, const Plasma::QueryMatch &match) override;
 
 private:
+    void updateSnapshot();
+
+    struct RecentDocument {
+        QString resource;
+        QUrl url;
+        QString title;
+    };
+
     QList<QAction *> m_actions;
+
+    /** Recently used resources of the current activity, kept up to date by KActivities */
+    KActivities::Stats::ResultModel *m_resultModel = nullptr;
+    /** Coalesces bursts of model changes into one snapshot update */
+    QTimer m_snapshotTimer;
+    /** Guards m_snapshot, which is written from the main thread and read from match threads */
+    QReadWriteLock m_snapshotLock;
+    QVector<RecentDocument> m_snapshot;
 };
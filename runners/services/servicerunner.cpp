@@ -31,6 +31,7 @@
 #include <KIO/DesktopExecParser>
 
 #include "debug.h"
+#include "../matchtimer.h"
 
 namespace
 {
@@ -435,6 +436,7 @@ ServiceRunner::~ServiceRunner() = default;
 
 void ServiceRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     // This helper class aids in keeping state across numerous
     // different queries that together form the matches set.
     ServiceFinder finder(this);
@@ -14,6 +14,7 @@
 #include "kworkspace.h"
 
 #include "screensaver_interface.h"
+#include "../matchtimer.h"
 
 K_PLUGIN_CLASS_WITH_JSON(SessionRunner, "plasma-runner-sessions.json")
 
@@ -102,6 +103,7 @@ void SessionRunner::matchCommands(QList<Plasma::QueryMatch> &matches, const QStr
 
 void SessionRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString term = context.query();
     QString user;
     bool matchUser = false;
@@ -20,6 +20,8 @@
 
 #include <KIO/CommandLauncherJob>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(ShellRunner, "plasma-runner-shell.json")
 
 ShellRunner::ShellRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -43,6 +45,7 @@ ShellRunner::~ShellRunner()
 
 void ShellRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     QStringList envs;
     std::optional<QString> parsingResult = parseShellCommand(context.query(), envs);
     if (parsingResult.has_value()) {
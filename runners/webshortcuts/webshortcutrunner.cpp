@@ -18,6 +18,8 @@
 #include <QAction>
 #include <QDBusConnection>
 
+#include "../matchtimer.h"
+
 WebshortcutRunner::WebshortcutRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
     : Plasma::AbstractRunner(parent, metaData, args)
     , m_match(this)
@@ -101,6 +103,7 @@ void WebshortcutRunner::configurePrivateBrowsingActions()
 
 void WebshortcutRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     const QString term = context.query();
     const static QRegularExpression bangRegex(QStringLiteral("!([^ ]+).*"));
     const auto bangMatch = bangRegex.match(term);
@@ -19,6 +19,8 @@
 #include <Plasma/PluginLoader>
 #include <QMutexLocker>
 
+#include "../matchtimer.h"
+
 K_PLUGIN_CLASS_WITH_JSON(WindowedWidgetsRunner, "plasma-runner-windowedwidgets.json")
 
 WindowedWidgetsRunner::WindowedWidgetsRunner(QObject *parent, const KPluginMetaData &metaData, const QVariantList &args)
@@ -42,6 +44,7 @@ WindowedWidgetsRunner::~WindowedWidgetsRunner()
 
 void WindowedWidgetsRunner::match(Plasma::RunnerContext &context)
 {
+    const MatchTimer timer(id(), context.query());
     loadMetadataList();
     const QString term = context.query();
     QList<Plasma::QueryMatch> matches;
@@ -39,6 +39,7 @@ private Q_SLOTS:
     void testThirdScreenRemoval();
     void testLastScreenRemoval();
     void testFakeToRealScreen();
+    void testClonedScreensInsertion();
 
 private:
     ScreenPool *m_screenPool;
@@ -411,6 +412,67 @@ void ScreenPoolTest::testFakeToRealScreen()
     QCOMPARE(m_screenPool->id(newScreen->name()), 0);
 }
 
+void ScreenPoolTest::testClonedScreensInsertion()
+{
+    QSignalSpy addedSpy(m_screenPool, SIGNAL(screenAdded(QScreen *)));
+    QSignalSpy addedFromAppSpy(qGuiApp, SIGNAL(screenAdded(QScreen *)));
+    QSignalSpy removedSpy(m_screenPool, SIGNAL(screenRemoved(QScreen *)));
+
+    // Add two outputs without a size yet, so they are fake and have no id
+    exec([=] {
+        OutputData data;
+        data.mode.resolution = {0, 0};
+        data.position = {1920, 0};
+        add<Output>(data);
+        add<Output>(data);
+    });
+
+    QTRY_COMPARE(addedFromAppSpy.size(), 2);
+    QCOMPARE(addedSpy.size(), 0);
+
+    // Both get the same geometry in one go
+    exec([=] {
+        for (int i : {1, 2}) {
+            auto *out = output(i);
+            out->m_data.mode.resolution = {1920, 1080};
+            out->m_data.physicalSize = out->m_data.mode.physicalSizeForDpi(96);
+            xdgOutput(out)->sendLogicalSize(QSize(1920, 1080));
+            out->sendDone();
+        }
+    });
+
+    addedSpy.wait();
+    addedSpy.wait(250);
+    // Only one of them is usable, the other one is redundant to it
+    QCOMPARE(addedSpy.size(), 1);
+    QCOMPARE(QGuiApplication::screens().size(), 3);
+    QCOMPARE(m_screenPool->screens().size(), 2);
+
+    QScreen *firstClone = addedFromAppSpy.at(0).at(0).value<QScreen *>();
+    QScreen *secondClone = addedFromAppSpy.at(1).at(0).value<QScreen *>();
+    QScreen *newScreen = addedSpy.takeFirst().at(0).value<QScreen *>();
+    QVERIFY(newScreen == firstClone || newScreen == secondClone);
+    QScreen *redundantScreen = newScreen == firstClone ? secondClone : firstClone;
+    QCOMPARE(newScreen->geometry(), QRect(1920, 0, 1920, 1080));
+    QCOMPARE(redundantScreen->geometry(), QRect(1920, 0, 1920, 1080));
+    QVERIFY(m_screenPool->screens().contains(newScreen));
+    QVERIFY(!m_screenPool->screens().contains(redundantScreen));
+
+    // Both got an id
+    QVERIFY(m_screenPool->id(newScreen->name()) > 0);
+    QVERIFY(m_screenPool->id(redundantScreen->name()) > 0);
+    QVERIFY(m_screenPool->id(newScreen->name()) != m_screenPool->id(redundantScreen->name()));
+
+    exec([=] {
+        remove(output(2));
+        remove(output(1));
+    });
+
+    QTRY_COMPARE(removedSpy.size(), 1);
+    QTRY_COMPARE(QGuiApplication::screens().size(), 1);
+    QCOMPARE(m_screenPool->screens().size(), 1);
+}
+
 QCOMPOSITOR_TEST_MAIN(ScreenPoolTest)
 
 #include "screenpooltest.moc"
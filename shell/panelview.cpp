@@ -13,6 +13,7 @@
 #include "panelview.h"
 #include "screenpool.h"
 #include "shellcorona.h"
+#include "windowmanagerwatcher.h"
 
 #include <QAction>
 #include <QApplication>
@@ -108,6 +109,15 @@ PanelView::PanelView(ShellCorona *corona, QScreen *targetScreen, QWindow *parent
     m_strutsTimer.setSingleShot(true);
     connect(&m_strutsTimer, &QTimer::timeout, this, &PanelView::updateStruts);
 
+    connect(this, &PanelView::locationChanged, this, &PanelView::invalidateStrutDecision);
+    connect(m_corona, &Plasma::Corona::screenAdded, this, &PanelView::invalidateStrutDecision);
+    connect(m_corona, &Plasma::Corona::screenRemoved, this, &PanelView::invalidateStrutDecision);
+    connect(m_corona, &Plasma::Corona::screenGeometryChanged, this, &PanelView::invalidateStrutDecision);
+    connect(m_corona->windowManagerWatcher(), &WindowManagerWatcher::windowManagerChanged, this, [this] {
+        invalidateStrutDecision();
+        m_strutsTimer.start(STRUTSTIMERDELAY);
+    });
+
     // Register enums
     qmlRegisterUncreatableMetaObject(PanelView::staticMetaObject, "org.kde.plasma.shell.panel", 0, 1, "Global", QStringLiteral("Error: only enums"));
 
@@ -232,7 +242,7 @@ void PanelView::setOffset(int offset)
     positionPanel();
     Q_EMIT offsetChanged();
     m_corona->requestApplicationConfigSync();
-    Q_EMIT m_corona->availableScreenRegionChanged();
+    m_corona->scheduleAvailableScreenRegionChange();
 }
 
 int PanelView::thickness() const
@@ -849,7 +859,7 @@ void PanelView::resizeEvent(QResizeEvent *ev)
         }
 
         m_strutsTimer.start(STRUTSTIMERDELAY);
-        Q_EMIT m_corona->availableScreenRegionChanged();
+        m_corona->scheduleAvailableScreenRegionChange();
     }
 
     PlasmaQuick::ContainmentView::resizeEvent(ev);
@@ -936,10 +946,13 @@ void PanelView::setScreenToFollow(QScreen *screen)
 
     if (!m_screenToFollow.isNull()) {
         // disconnect from old screen
+        disconnect(m_screenToFollow, &QScreen::virtualGeometryChanged, this, &PanelView::invalidateStrutDecision);
         disconnect(m_screenToFollow, &QScreen::virtualGeometryChanged, this, &PanelView::updateStruts);
         disconnect(m_screenToFollow, &QScreen::geometryChanged, this, &PanelView::restore);
     }
+    invalidateStrutDecision();
 
+    connect(screen, &QScreen::virtualGeometryChanged, this, &PanelView::invalidateStrutDecision, Qt::UniqueConnection);
     connect(screen, &QScreen::virtualGeometryChanged, this, &PanelView::updateStruts, Qt::UniqueConnection);
     connect(screen, &QScreen::geometryChanged, this, &PanelView::restore, Qt::UniqueConnection);
 
@@ -1190,16 +1203,31 @@ void PanelView::updateMask()
     }
 }
 
+void PanelView::invalidateStrutDecision()
+{
+    m_canSetStrut.reset();
+}
+
 bool PanelView::canSetStrut() const
 {
 #if HAVE_X11
     if (!KWindowSystem::isPlatformX11()) {
         return true;
     }
-    // read the wm name, need to do this every time which means a roundtrip unfortunately
-    // but WM might have changed
-    NETRootInfo rootInfo(QX11Info::connection(), NET::Supported | NET::SupportingWMCheck);
-    if (qstricmp(rootInfo.wmName(), "KWin") == 0) {
+    if (m_canSetStrut.has_value()) {
+        return *m_canSetStrut;
+    }
+    m_canSetStrut = computeCanSetStrut();
+    return *m_canSetStrut;
+#else
+    return true;
+#endif
+}
+
+bool PanelView::computeCanSetStrut() const
+{
+#if HAVE_X11
+    if (m_corona->windowManagerWatcher()->isKWin()) {
         // KWin since 5.7 can handle this fine, so only exclude for other window managers
         return true;
     }
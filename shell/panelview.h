@@ -16,6 +16,8 @@
 #include <PlasmaQuick/ConfigView>
 #include <PlasmaQuick/ContainmentView>
 
+#include <optional>
+
 class ShellCorona;
 
 namespace KWayland
@@ -253,6 +255,8 @@ private:
     void visibilityModeToWayland();
     bool edgeActivated() const;
     bool canSetStrut() const;
+    bool computeCanSetStrut() const;
+    void invalidateStrutDecision();
 
     int m_offset;
     int m_maxLength;
@@ -276,6 +280,8 @@ private:
     QPointer<PlasmaQuick::ConfigView> m_panelConfigView;
     ShellCorona *m_corona;
     QTimer m_strutsTimer;
+    // canSetStrut() only changes with the screen layout, the panel location and the window manager
+    mutable std::optional<bool> m_canSetStrut;
     VisibilityMode m_visibilityMode;
     OpacityMode m_opacityMode;
     Plasma::Theme m_theme;
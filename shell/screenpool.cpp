@@ -12,6 +12,7 @@
 #include <QDebug>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QVector>
 
 #ifndef NDEBUG
 #define CHECK_SCREEN_INVARIANTS screenInvariants();
@@ -279,20 +280,76 @@ QScreen *ScreenPool::outputRedundantTo(QScreen *screen) const
     return nullptr;
 }
 
+void ScreenPool::markOutputsToReconsider(QScreen *screen)
+{
+    // Redundancy only depends on containment, so a change of this screen can only affect
+    // itself, the screens that were redundant to it and the screens it contains now
+    m_outputsToReconsider.insert(screen);
+    for (auto it = m_redundantScreens.cbegin(); it != m_redundantScreens.cend(); ++it) {
+        if (it.value() == screen) {
+            m_outputsToReconsider.insert(it.key());
+        }
+    }
+
+    const QRect geometry = screen->geometry();
+    if (geometry.isNull()) {
+        return;
+    }
+    for (QScreen *s : std::as_const(m_allSortedScreens)) {
+        if (s != screen && geometry.contains(s->geometry(), false)) {
+            m_outputsToReconsider.insert(s);
+        }
+    }
+}
+
+void ScreenPool::markAllOutputsToReconsider()
+{
+    for (QScreen *screen : std::as_const(m_allSortedScreens)) {
+        m_outputsToReconsider.insert(screen);
+    }
+}
+
+void ScreenPool::screenGeometryChanged(QScreen *screen)
+{
+    m_allSortedScreens.removeAll(screen);
+    insertSortedScreen(screen);
+    markOutputsToReconsider(screen);
+    m_reconsiderOutputsTimer.start();
+}
+
 void ScreenPool::reconsiderOutputs()
 {
+    // Work out which screens are fake first, so the signals below are a diff
+    // between two consistent states and no screen flips back and forth in one pass
+    struct OutputState {
+        QScreen *screen;
+        QScreen *redundantTo;
+        bool fake;
+    };
+    QVector<OutputState> states;
+    for (QScreen *screen : std::as_const(m_allSortedScreens)) {
+        if (m_outputsToReconsider.contains(screen)) {
+            states.append({screen, nullptr, isOutputFake(screen)});
+        }
+    }
+    m_outputsToReconsider.clear();
+
     QScreen *oldPrimaryScreen = primaryScreen();
-    for (QScreen *screen : m_allSortedScreens) {
+    for (OutputState &state : states) {
+        QScreen *screen = state.screen;
+        // Redundancy depends on the ids, which the screens before this one may just have got,
+        // so of two cloned screens appearing together the second one is redundant to the first
+        state.redundantTo = outputRedundantTo(screen);
         if (m_redundantScreens.contains(screen)) {
-            if (QScreen *toScreen = outputRedundantTo(screen)) {
+            if (QScreen *toScreen = state.redundantTo) {
                 // Insert again, redndantTo may have changed
                 m_fakeScreens.remove(screen);
                 m_redundantScreens.insert(screen, toScreen);
             } else {
-                qCDebug(SCREENPOOL) << "not redundant anymore" << screen << (isOutputFake(screen) ? "but is a fake screen" : "");
+                qCDebug(SCREENPOOL) << "not redundant anymore" << screen << (state.fake ? "but is a fake screen" : "");
                 Q_ASSERT(!m_availableScreens.contains(screen));
                 m_redundantScreens.remove(screen);
-                if (isOutputFake(screen)) {
+                if (state.fake) {
                     m_fakeScreens.insert(screen);
                 } else {
                     m_fakeScreens.remove(screen);
@@ -309,7 +366,7 @@ void ScreenPool::reconsiderOutputs()
                     }
                 }
             }
-        } else if (QScreen *toScreen = outputRedundantTo(screen)) {
+        } else if (QScreen *toScreen = state.redundantTo) {
             qCDebug(SCREENPOOL) << "new redundant screen" << screen << "with primary screen" << m_primaryWatcher->primaryScreen();
 
             m_fakeScreens.remove(screen);
@@ -327,7 +384,7 @@ void ScreenPool::reconsiderOutputs()
                 m_availableScreens.removeAll(screen);
                 Q_EMIT screenRemoved(screen);
             }
-        } else if (isOutputFake(screen)) {
+        } else if (state.fake) {
             // NOTE: order of operations is important
             qCDebug(SCREENPOOL) << "new fake screen" << screen;
             m_redundantScreens.remove(screen);
@@ -387,12 +444,11 @@ void ScreenPool::handleScreenAdded(QScreen *screen)
         &QScreen::geometryChanged,
         this,
         [this, screen]() {
-            m_allSortedScreens.removeAll(screen);
-            insertSortedScreen(screen);
-            m_reconsiderOutputsTimer.start();
+            screenGeometryChanged(screen);
         },
         Qt::UniqueConnection);
     insertSortedScreen(screen);
+    markOutputsToReconsider(screen);
 
     if (isOutputFake(screen)) {
         m_fakeScreens.insert(screen);
@@ -420,6 +476,8 @@ void ScreenPool::handleScreenAdded(QScreen *screen)
 void ScreenPool::handleScreenRemoved(QScreen *screen)
 {
     qCDebug(SCREENPOOL) << "handleScreenRemoved" << screen;
+    markOutputsToReconsider(screen);
+    m_outputsToReconsider.remove(screen);
     m_allSortedScreens.removeAll(screen);
     if (m_redundantScreens.contains(screen)) {
         Q_ASSERT(!m_fakeScreens.contains(screen));
@@ -454,6 +512,8 @@ void ScreenPool::handlePrimaryOutputNameChanged(const QString &oldOutputName, co
     // when the appearance of a new primary screen *moves*
     // the position of the now secondary, the two screens will appear overlapped for an instant, and a spurious output redundant would happen here if checked
     // immediately
+    // The ids decide between screens with the same geometry, and the primary one gets id 0
+    markAllOutputsToReconsider();
     m_reconsiderOutputsTimer.start();
 
     QScreen *oldPrimary = screenForConnector(oldOutputName);
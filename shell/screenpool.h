@@ -57,6 +57,9 @@ private:
     int firstAvailableId() const;
 
     QScreen *outputRedundantTo(QScreen *screen) const;
+    void screenGeometryChanged(QScreen *screen);
+    void markOutputsToReconsider(QScreen *screen);
+    void markAllOutputsToReconsider();
     void reconsiderOutputs();
     bool isOutputFake(QScreen *screen) const;
 
@@ -80,6 +83,8 @@ private:
     QList<QScreen *> m_availableScreens; // Those are all the screen that are available to Corona
     QHash<QScreen *, QScreen *> m_redundantScreens;
     QSet<QScreen *> m_fakeScreens;
+    // Only these can have changed their redundant or fake state since the last reconsiderOutputs()
+    QSet<QScreen *> m_outputsToReconsider;
 
     QTimer m_reconsiderOutputsTimer;
     QTimer m_configSaveTimer;
@@ -44,6 +44,10 @@ ScriptEngine::ScriptEngine(Plasma::Corona *corona, QObject *parent)
     , m_corona(corona)
 {
     Q_ASSERT(m_corona);
+    // Scripts work on the whole layout
+    if (ShellCorona *sc = qobject_cast<ShellCorona *>(m_corona)) {
+        sc->loadDeferredContainments(ShellCorona::DeferredContainments::All);
+    }
     m_appInterface = new AppInterface(this);
     connect(m_appInterface, &AppInterface::print, this, &ScriptEngine::print);
     m_scriptSelf = globalObject();
@@ -15,12 +15,16 @@
 
 #include <QApplication>
 #include <QDBusConnection>
+#include <QDateTime>
 #include <QDebug>
 #include <QMenu>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QQuickItemGrabResult>
+#include <QSaveFile>
 #include <QScreen>
 #include <QUrl>
+#include <QtConcurrent>
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -58,6 +62,7 @@
 #include "screenpool.h"
 #include "scripting/scriptengine.h"
 #include "shellcontainmentconfig.h"
+#include "windowmanagerwatcher.h"
 
 #include "debug.h"
 #include "futureutil.h"
@@ -93,8 +98,11 @@ ShellCorona::ShellCorona(QObject *parent)
     , m_waylandPlasmaShell(nullptr)
     , m_closingDown(false)
     , m_strutManager(new StrutManager(this))
+    , m_windowManagerWatcher(new WindowManagerWatcher(this))
     , m_shellContainmentConfig(nullptr)
 {
+    m_startupTimer.start();
+    m_containmentPreviewThreadPool.setMaxThreadCount(1);
     setupWaylandIntegration();
     qmlRegisterUncreatableType<DesktopView>("org.kde.plasma.shell", 2, 0, "Desktop", QStringLiteral("It is not possible to create objects of type Desktop"));
     qmlRegisterUncreatableType<PanelView>("org.kde.plasma.shell", 2, 0, "Panel", QStringLiteral("It is not possible to create objects of type Panel"));
@@ -128,6 +136,17 @@ void ShellCorona::init()
 
     connect(this, &Plasma::Corona::availableScreenRectChanged, this, &Plasma::Corona::availableScreenRegionChanged);
 
+    m_availableScreenChangeTimer.setSingleShot(true);
+    m_availableScreenChangeTimer.setInterval(0);
+    connect(&m_availableScreenChangeTimer, &QTimer::timeout, this, [this]() {
+        if (std::exchange(m_availableScreenRectChangePending, false)) {
+            // the region change follows through the connection above
+            Q_EMIT availableScreenRectChanged();
+        } else {
+            Q_EMIT availableScreenRegionChanged();
+        }
+    });
+
     m_appConfigSyncTimer.setSingleShot(true);
     m_appConfigSyncTimer.setInterval(s_configSyncDelay);
     connect(&m_appConfigSyncTimer, &QTimer::timeout, this, &ShellCorona::syncAppConfig);
@@ -257,6 +276,7 @@ void ShellCorona::init()
     manageContainmentsAction->setText(i18n("Manage Desktops And Panels..."));
     connect(manageContainmentsAction, &QAction::triggered, this, [this]() {
         if (m_shellContainmentConfig == nullptr) {
+            loadDeferredContainments(DeferredContainments::All);
             m_shellContainmentConfig = new ShellContainmentConfig(this);
             m_shellContainmentConfig->init();
         }
@@ -452,8 +472,10 @@ QJsonObject dumpconfigGroupJS(const KConfigGroup &rootGroup)
     return result;
 }
 
-QByteArray ShellCorona::dumpCurrentLayoutJS() const
+QByteArray ShellCorona::dumpCurrentLayoutJS()
 {
+    loadDeferredContainments(DeferredContainments::All);
+
     QJsonObject root;
     root.insert("serializationFormatVersion", "1");
 
@@ -710,8 +732,24 @@ void ShellCorona::load()
     // TODO: a kconf_update script is needed
     QString configFileName(QStringLiteral("plasma-") + m_shell + QStringLiteral("-appletsrc"));
 
+    // The corona opens the same shared config, so what we hide in here stays hidden from loadLayout()
+    KSharedConfig::Ptr layout;
+    if (KConfigGroup(applicationConfig(), "General").readEntry("deferInactiveContainments", false)) {
+        layout = KSharedConfig::openConfig(configFileName, KConfig::SimpleConfig);
+        deferInactiveContainments(layout);
+    }
+
     loadLayout(configFileName);
 
+    if (m_deferredContainments) {
+        // Writes what loading changed and reads the hidden containments back from the file
+        layout->reparseConfiguration();
+        if (config() != layout) {
+            // The corona read its own copy, so everything got loaded anyway
+            m_deferredContainments.reset();
+        }
+    }
+
     checkActivities();
 
     if (containments().isEmpty()) {
@@ -723,28 +761,7 @@ void ShellCorona::load()
         processUpdateScripts();
     } else {
         processUpdateScripts();
-        const auto containments = this->containments();
-        for (Plasma::Containment *containment : containments) {
-            if (containment->containmentType() == Plasma::Types::PanelContainment || containment->containmentType() == Plasma::Types::CustomPanelContainment) {
-                // Don't give a view to containments that don't want one (negative lastscreen)
-                //(this is pretty mucha special case for the systray)
-                // also, make sure we don't have a view already.
-                // this will be true for first startup as the view has already been created at the new Panel JS call
-                if (!m_waitingPanels.contains(containment) && containment->lastScreen() >= 0 && !m_panelViews.contains(containment)) {
-                    m_waitingPanels << containment;
-                }
-                // historically CustomContainments are treated as desktops
-            } else if (containment->containmentType() == Plasma::Types::DesktopContainment
-                       || containment->containmentType() == Plasma::Types::CustomContainment) {
-                // FIXME ideally fix this, or at least document the crap out of it
-                int screen = containment->lastScreen();
-                if (screen < 0) {
-                    screen = 0;
-                    qCWarning(PLASMASHELL) << "last screen is < 0 so putting containment on screen " << screen;
-                }
-                insertContainment(containment->activity(), screen, containment);
-            }
-        }
+        placeLoadedContainments(containments());
     }
 
     // NOTE: this is needed in case loadLayout() did *not* call loadDefaultLayout()
@@ -774,6 +791,185 @@ void ShellCorona::load()
     }
 }
 
+void ShellCorona::placeLoadedContainments(const QList<Plasma::Containment *> &containments)
+{
+    for (Plasma::Containment *containment : containments) {
+        if (containment->containmentType() == Plasma::Types::PanelContainment || containment->containmentType() == Plasma::Types::CustomPanelContainment) {
+            // Don't give a view to containments that don't want one (negative lastscreen)
+            //(this is pretty mucha special case for the systray)
+            // also, make sure we don't have a view already.
+            // this will be true for first startup as the view has already been created at the new Panel JS call
+            if (!m_waitingPanels.contains(containment) && containment->lastScreen() >= 0 && !m_panelViews.contains(containment)) {
+                m_waitingPanels << containment;
+            }
+            // historically CustomContainments are treated as desktops
+        } else if (containment->containmentType() == Plasma::Types::DesktopContainment
+                   || containment->containmentType() == Plasma::Types::CustomContainment) {
+            // FIXME ideally fix this, or at least document the crap out of it
+            int screen = containment->lastScreen();
+            if (screen < 0) {
+                screen = 0;
+                qCWarning(PLASMASHELL) << "last screen is < 0 so putting containment on screen " << screen;
+            }
+            insertContainment(containment->activity(), screen, containment);
+        }
+    }
+}
+
+// Containments an applet of this one depends on, like the system tray of a panel
+static QStringList referencedContainments(const KConfigGroup &containment)
+{
+    QStringList ids;
+    const KConfigGroup applets(&containment, "Applets");
+    const QStringList appletIds = applets.groupList();
+    for (const QString &appletId : appletIds) {
+        const uint id = KConfigGroup(&applets, appletId).group("Configuration").readEntry("SystrayContainmentId", 0u);
+        if (id > 0) {
+            ids << QString::number(id);
+        }
+    }
+    return ids;
+}
+
+bool ShellCorona::isDeferrable(const KConfigGroup &containment) const
+{
+    const QString activity = containment.readEntry("activityId", QString());
+    if (!activity.isEmpty() && activity != m_activityController->currentActivity()) {
+        // The ones of removed activities are loaded to be cleaned up by checkActivities()
+        return m_activityController->activities().contains(activity);
+    }
+
+    const int screen = containment.readEntry("lastScreen", -1);
+    if (screen < 0) {
+        return false;
+    }
+    const auto screens = m_screenPool->screens();
+    return std::none_of(screens.cbegin(), screens.cend(), [this, screen](const QScreen *s) {
+        return m_screenPool->id(s->name()) == screen;
+    });
+}
+
+// The highest id used by the containment or any of its applets
+static uint highestId(const KConfigGroup &containment)
+{
+    uint id = containment.name().toUInt();
+    const QStringList appletIds = KConfigGroup(&containment, "Applets").groupList();
+    for (const QString &appletId : appletIds) {
+        id = std::max(id, appletId.toUInt());
+    }
+    return id;
+}
+
+void ShellCorona::deferInactiveContainments(const KSharedConfig::Ptr &layout)
+{
+    KConfigGroup containmentsGroup(layout, "Containments");
+    const QStringList ids = containmentsGroup.groupList();
+
+    QSet<QString> deferred;
+    QString highestIdHolder;
+    uint highest = 0;
+    for (const QString &id : ids) {
+        const KConfigGroup group(&containmentsGroup, id);
+        if (isDeferrable(group)) {
+            deferred.insert(id);
+        }
+        if (highestId(group) >= highest) {
+            highest = highestId(group);
+            highestIdHolder = id;
+        }
+    }
+    // libplasma numbers new containments and applets after the ones it loaded,
+    // loading the one with the highest id keeps them off the ids of the deferred ones
+    deferred.remove(highestIdHolder);
+    for (const QString &id : ids) {
+        if (!deferred.contains(id)) {
+            const QStringList references = referencedContainments(KConfigGroup(&containmentsGroup, id));
+            for (const QString &reference : references) {
+                deferred.remove(reference);
+            }
+        }
+    }
+    if (deferred.isEmpty()) {
+        return;
+    }
+
+    // Whatever is pending gets written now, markAsClean() below would drop it otherwise
+    layout->sync();
+
+    m_deferredContainments = std::make_unique<KConfig>(QString(), KConfig::SimpleConfig);
+    KConfigGroup deferredGroup(m_deferredContainments.get(), "Containments");
+    for (const QString &id : std::as_const(deferred)) {
+        KConfigGroup group(&containmentsGroup, id);
+        KConfigGroup target(&deferredGroup, id);
+        group.copyTo(&target);
+        group.deleteGroup();
+    }
+    // Hidden from loadLayout() only: clean deletions are never written to the file,
+    // whenever the config gets synced, and load() reads the groups back afterwards
+    layout->markAsClean();
+    qCDebug(PLASMASHELL) << "Deferring the loading of containments" << deferred;
+}
+
+void ShellCorona::loadDeferredContainments(DeferredContainments which)
+{
+    loadDeferredContainmentsIf([this, which](const KConfigGroup &containment) {
+        return which == DeferredContainments::All || !isDeferrable(containment);
+    });
+}
+
+void ShellCorona::loadDeferredContainments(const QString &activity)
+{
+    loadDeferredContainmentsIf([&activity](const KConfigGroup &containment) {
+        return containment.readEntry("activityId", QString()) == activity;
+    });
+}
+
+void ShellCorona::loadDeferredContainmentsIf(const std::function<bool(const KConfigGroup &)> &filter)
+{
+    if (!m_deferredContainments) {
+        return;
+    }
+
+    KConfig batch(QString(), KConfig::SimpleConfig);
+    KConfigGroup batchGroup(&batch, "Containments");
+    {
+        KConfigGroup deferredGroup(m_deferredContainments.get(), "Containments");
+        QStringList ids;
+        const QStringList deferredIds = deferredGroup.groupList();
+        for (const QString &id : deferredIds) {
+            const KConfigGroup group(&deferredGroup, id);
+            if (filter(group)) {
+                ids << id << referencedContainments(group);
+            }
+        }
+        ids.removeDuplicates();
+
+        for (const QString &id : std::as_const(ids)) {
+            KConfigGroup group(&deferredGroup, id);
+            // References may point to containments which are loaded already
+            if (!group.exists()) {
+                continue;
+            }
+            KConfigGroup target(&batchGroup, id);
+            group.copyTo(&target);
+            group.deleteGroup();
+        }
+        if (batchGroup.groupList().isEmpty()) {
+            return;
+        }
+    }
+    if (KConfigGroup(m_deferredContainments.get(), "Containments").groupList().isEmpty()) {
+        m_deferredContainments.reset();
+    }
+
+    qCDebug(PLASMASHELL) << "Loading deferred containments" << batchGroup.groupList();
+    // Keeps the ids, since none of them is in use
+    placeLoadedContainments(importLayout(KConfigGroup(&batch, QString())));
+    if (!m_waitingPanels.isEmpty()) {
+        m_waitingPanelsTimer.start();
+    }
+}
+
 void ShellCorona::primaryScreenChanged(QScreen *oldPrimary, QScreen *newPrimary)
 {
     // when the appearance of a new primary screen *moves*
@@ -894,6 +1090,8 @@ void ShellCorona::unload()
     if (m_shell.isEmpty()) {
         return;
     }
+    // Their config stays where it is, for whoever loads the layout next
+    m_deferredContainments.reset();
     qDeleteAll(m_desktopViewForScreen);
     m_desktopViewForScreen.clear();
     qDeleteAll(m_panelViews);
@@ -997,7 +1195,6 @@ void ShellCorona::processUpdateScripts()
     if (scripts.isEmpty()) {
         return;
     }
-
     WorkspaceScripting::ScriptEngine scriptEngine(this);
 
     connect(&scriptEngine, &WorkspaceScripting::ScriptEngine::printError, this, [](const QString &msg) {
@@ -1035,6 +1232,18 @@ QRect ShellCorona::screenGeometry(int id) const
     return view->geometry();
 }
 
+void ShellCorona::scheduleAvailableScreenRectChange()
+{
+    m_availableScreenRectChangePending = true;
+    scheduleAvailableScreenRegionChange();
+}
+
+void ShellCorona::scheduleAvailableScreenRegionChange()
+{
+    m_strutManager->invalidateCache();
+    m_availableScreenChangeTimer.start();
+}
+
 QRegion ShellCorona::availableScreenRegion(int id) const
 {
     return m_strutManager->availableScreenRegion(id);
@@ -1189,6 +1398,8 @@ void ShellCorona::addOutput(QScreen *screen)
         return;
     }
     Q_ASSERT(!screen->geometry().isNull());
+    // Before looking for the containment of this screen, it may not be loaded yet
+    loadDeferredContainments();
 #ifndef NDEBUG
     connect(screen, &QScreen::geometryChanged, &m_invariantsTimer, static_cast<void (QTimer::*)()>(&QTimer::start), Qt::UniqueConnection);
 #endif
@@ -1204,8 +1415,7 @@ void ShellCorona::addOutput(QScreen *screen)
         const int id = m_screenPool->id(view->screen()->name());
         if (id >= 0) {
             Q_EMIT screenGeometryChanged(id);
-            Q_EMIT availableScreenRegionChanged();
-            Q_EMIT availableScreenRectChanged();
+            scheduleAvailableScreenRectChange();
         }
     });
 
@@ -1233,7 +1443,7 @@ void ShellCorona::addOutput(QScreen *screen)
         m_waitingPanelsTimer.start();
     }
 
-    Q_EMIT availableScreenRectChanged();
+    scheduleAvailableScreenRectChange();
     Q_EMIT screenAdded(m_screenPool->id(screen->name()));
 #ifndef NDEBUG
     m_invariantsTimer.start();
@@ -1260,6 +1470,9 @@ void ShellCorona::checkAllDesktopsUiReady(bool ready)
 
 Plasma::Containment *ShellCorona::createContainmentForActivity(const QString &activity, int screenNum)
 {
+    // The activity may have one for this screen which is not loaded yet
+    loadDeferredContainments(activity);
+
     const auto containments = containmentsForActivity(activity);
     for (Plasma::Containment *cont : containments) {
         // in the case of a corrupt config file
@@ -1312,11 +1525,20 @@ void ShellCorona::createWaitingPanels()
         if (panel->rendererInterface()->graphicsApi() != QSGRendererInterface::Software) {
             connect(panel, &QQuickWindow::sceneGraphError, this, &ShellCorona::glInitializationFailed);
         }
-        connect(panel, &QWindow::visibleChanged, this, &Plasma::Corona::availableScreenRectChanged);
-        connect(panel, &QWindow::screenChanged, this, &Plasma::Corona::availableScreenRectChanged);
-        connect(panel, &PanelView::locationChanged, this, &Plasma::Corona::availableScreenRectChanged);
-        connect(panel, &PanelView::visibilityModeChanged, this, &Plasma::Corona::availableScreenRectChanged);
-        connect(panel, &PanelView::thicknessChanged, this, &Plasma::Corona::availableScreenRectChanged);
+        connect(panel, &QWindow::visibleChanged, this, &ShellCorona::scheduleAvailableScreenRectChange);
+        connect(panel, &QWindow::screenChanged, this, &ShellCorona::scheduleAvailableScreenRectChange);
+        connect(panel, &PanelView::locationChanged, this, &ShellCorona::scheduleAvailableScreenRectChange);
+        connect(panel, &PanelView::visibilityModeChanged, this, &ShellCorona::scheduleAvailableScreenRectChange);
+        connect(panel, &PanelView::thicknessChanged, this, &ShellCorona::scheduleAvailableScreenRectChange);
+        // Moving along the edge doesn't announce a change, but the region depends on the position
+        connect(panel, &QWindow::xChanged, m_strutManager, &StrutManager::invalidateCache);
+        connect(panel, &QWindow::yChanged, m_strutManager, &StrutManager::invalidateCache);
+        connect(panel, &QWindow::widthChanged, m_strutManager, &StrutManager::invalidateCache);
+        connect(panel, &QWindow::heightChanged, m_strutManager, &StrutManager::invalidateCache);
+
+        if (m_firstPanelFrameTime < 0) {
+            connect(panel, &QQuickWindow::frameSwapped, this, &ShellCorona::reportFirstPanelFrame);
+        }
 
         m_panelViews[cont] = panel;
         panel->setContainment(cont);
@@ -1325,7 +1547,25 @@ void ShellCorona::createWaitingPanels()
         connect(cont, &QObject::destroyed, this, &ShellCorona::panelContainmentDestroyed);
     }
     m_waitingPanels = stillWaitingPanels;
-    Q_EMIT availableScreenRectChanged();
+    scheduleAvailableScreenRectChange();
+}
+
+void ShellCorona::reportFirstPanelFrame()
+{
+    if (m_firstPanelFrameTime >= 0) {
+        return;
+    }
+    m_firstPanelFrameTime = m_startupTimer.elapsed();
+    qCInfo(PLASMASHELL) << "First panel frame shown after" << m_firstPanelFrameTime << "ms";
+
+    for (PanelView *panel : std::as_const(m_panelViews)) {
+        disconnect(panel, &QQuickWindow::frameSwapped, this, &ShellCorona::reportFirstPanelFrame);
+    }
+}
+
+int ShellCorona::firstPanelFrameTime() const
+{
+    return m_firstPanelFrameTime;
 }
 
 void ShellCorona::panelContainmentDestroyed(QObject *cont)
@@ -1335,7 +1575,7 @@ void ShellCorona::panelContainmentDestroyed(QObject *cont)
     // don't make things relayout when the application is quitting
     // NOTE: qApp->closingDown() is still false here
     if (!m_closingDown) {
-        Q_EMIT availableScreenRectChanged();
+        scheduleAvailableScreenRectChange();
     }
 }
 
@@ -1352,6 +1592,7 @@ void ShellCorona::handleContainmentAdded(Plasma::Containment *c)
         if (!destroyed) {
             return;
         }
+        m_containmentPreviewHashes.remove(c->id());
         const QString snapshotPath = containmentPreviewPath(c);
         if (!snapshotPath.isEmpty()) {
             QFile f(snapshotPath);
@@ -1516,6 +1757,7 @@ void ShellCorona::checkActivities()
 void ShellCorona::currentActivityChanged(const QString &newActivity)
 {
     //     qCDebug(PLASMASHELL) << "Activity changed:" << newActivity;
+    loadDeferredContainments();
 
     for (auto it = m_desktopViewForScreen.constBegin(); it != m_desktopViewForScreen.constEnd(); ++it) {
         Plasma::Containment *c = createContainmentForActivity(newActivity, m_screenPool->id(it.key()->name()));
@@ -1542,6 +1784,19 @@ void ShellCorona::activityAdded(const QString &id)
 void ShellCorona::activityRemoved(const QString &id)
 {
     m_activityContainmentPlugins.remove(id);
+    if (m_deferredContainments) {
+        // Not worth loading them just to destroy them
+        KConfigGroup deferredGroup(m_deferredContainments.get(), "Containments");
+        KConfigGroup containmentsGroup(config(), "Containments");
+        const QStringList deferredIds = deferredGroup.groupList();
+        for (const QString &containmentId : deferredIds) {
+            if (KConfigGroup(&deferredGroup, containmentId).readEntry("activityId", QString()) == id) {
+                KConfigGroup(&deferredGroup, containmentId).deleteGroup();
+                KConfigGroup(&containmentsGroup, containmentId).deleteGroup();
+            }
+        }
+        requestConfigSync();
+    }
     const QList<Plasma::Containment *> containments = containmentsForActivity(id);
     for (auto cont : containments) {
         cont->destroy();
@@ -1667,7 +1922,7 @@ Plasma::Containment *ShellCorona::setContainmentTypeForScreen(int screen, const
     // Save now as we now have a screen, so lastScreen will not be -1
     newContainment->save(newCg);
     requestConfigSync();
-    Q_EMIT availableScreenRectChanged();
+    scheduleAvailableScreenRectChange();
 
     return newContainment;
 }
@@ -1834,6 +2089,8 @@ Plasma::Containment *ShellCorona::addPanel(const QString &plugin)
 
 void ShellCorona::swapDesktopScreens(int oldScreen, int newScreen)
 {
+    // The containments of the other activities move along
+    loadDeferredContainments(DeferredContainments::All);
     for (auto *containment : containmentsForScreen(oldScreen)) {
         if (containment->containmentType() != Plasma::Types::PanelContainment
             && containment->containmentType() != Plasma::Types::CustomPanelContainment) {
@@ -1985,8 +2242,81 @@ int ShellCorona::screenForContainment(const Plasma::Containment *containment) co
     return -1;
 }
 
+// DataLocation is plasmashell, we need just "plasma"
+static QString containmentPreviewDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/plasma/containmentpreviews/");
+}
+
+static QString containmentPreviewFileName(Plasma::Containment *containment)
+{
+    return QString::number(containment->id()) + QChar('-') + containment->activity() + QStringLiteral(".png");
+}
+
+// Previews of containments that are gone or were not looked at for a long time are dropped first
+static constexpr qint64 s_maxContainmentPreviewCacheSize = 16 * 1024 * 1024;
+
+static void evictContainmentPreviews(const QString &keepPath)
+{
+    QDir dir(containmentPreviewDirectory());
+    const QFileInfoList previews = dir.entryInfoList({QStringLiteral("*.png")}, QDir::Files, QDir::Time);
+    qint64 size = 0;
+    for (const QFileInfo &preview : previews) {
+        size += preview.size();
+        if (size > s_maxContainmentPreviewCacheSize && preview.filePath() != keepPath) {
+            QFile file(preview.filePath());
+            if (!file.remove() && file.exists()) {
+                // Still takes the space, so it keeps counting
+                qCWarning(PLASMASHELL) << "Could not remove the containment preview" << preview.filePath() << file.errorString();
+                continue;
+            }
+            size -= preview.size();
+        }
+    }
+}
+
+// How long a grab and writing its result may take before the next one is allowed
+static constexpr auto s_containmentPreviewTimeout = 30s;
+
+struct ContainmentPreviewResult {
+    size_t hash = 0;
+    bool written = false;
+};
+
+// Runs in m_containmentPreviewThreadPool
+static ContainmentPreviewResult writeContainmentPreview(const QImage &image, const QString &path, size_t previousHash)
+{
+    ContainmentPreviewResult result;
+    result.hash = qHashBits(image.constBits(), image.sizeInBytes(), uint(image.width()) << 16 | uint(image.height()));
+    if (result.hash == previousHash) {
+        QFile file(path);
+        if (file.open(QIODevice::ReadWrite)) {
+            // Still in use, keep it away from the eviction
+            file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+            return result;
+        }
+    }
+
+    QDir().mkpath(containmentPreviewDirectory());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+        qCWarning(PLASMASHELL) << "Could not save the containment preview" << path << file.errorString();
+        return result;
+    }
+    result.written = true;
+    evictContainmentPreviews(path);
+    return result;
+}
+
 void ShellCorona::grabContainmentPreview(Plasma::Containment *containment)
 {
+    // The model of the containment configuration asks again and again, one grab at a time is enough.
+    // A grab which never reports back, like one of a window which got hidden, stops blocking after a while
+    const auto pending = m_pendingContainmentPreviews.constFind(containment->id());
+    if (pending != m_pendingContainmentPreviews.cend() && !pending->hasExpired()) {
+        return;
+    }
+
     QQuickWindow *viewToGrab = nullptr;
     QScreen *containmentQScreen = m_screenPool->screenForId(containment->screen());
     if (containment->containmentType() == Plasma::Types::PanelContainment || containment->containmentType() == Plasma::Types::CustomPanelContainment) {
@@ -2009,15 +2339,30 @@ void ShellCorona::grabContainmentPreview(Plasma::Containment *containment)
         auto result = viewToGrab->contentItem()->grabToImage(size);
 
         if (result) {
-            connect(result.data(), &QQuickItemGrabResult::ready, this, [this, result, containment]() {
-                // DataLocation is plasmashell, we need just "plasma"
-                QString path = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/plasma/");
-                QDir dir(path);
-                dir.mkdir(QStringLiteral("containmentpreviews"));
-                path +=
-                    QStringLiteral("containmentpreviews/") + QString::number(containment->id()) + QChar('-') + containment->activity() + QStringLiteral(".png");
-                result->saveToFile(path);
-                emit containmentPreviewReady(containment, path);
+            const int id = containment->id();
+            m_pendingContainmentPreviews.insert(id, QDeadlineTimer(s_containmentPreviewTimeout));
+            connect(result.data(), &QQuickItemGrabResult::ready, this, [this, result, id, containment = QPointer<Plasma::Containment>(containment)]() {
+                if (!containment) {
+                    m_pendingContainmentPreviews.remove(id);
+                    return;
+                }
+                const QString path = containmentPreviewDirectory() + containmentPreviewFileName(containment);
+                // PNG encoding is way too slow for the GUI thread
+                auto *watcher = new QFutureWatcher<ContainmentPreviewResult>(this);
+                connect(watcher, &QFutureWatcher<ContainmentPreviewResult>::finished, this, [this, watcher, id, path, containment]() {
+                    watcher->deleteLater();
+                    m_pendingContainmentPreviews.remove(id);
+                    const ContainmentPreviewResult previewResult = watcher->result();
+                    if (!previewResult.written && !QFile::exists(path)) {
+                        return;
+                    }
+                    m_containmentPreviewHashes[id] = previewResult.hash;
+                    if (containment) {
+                        Q_EMIT containmentPreviewReady(containment, path);
+                    }
+                });
+                watcher->setFuture(
+                    QtConcurrent::run(&m_containmentPreviewThreadPool, writeContainmentPreview, result->image(), path, m_containmentPreviewHashes.value(id)));
             });
         }
     }
@@ -2025,8 +2370,7 @@ void ShellCorona::grabContainmentPreview(Plasma::Containment *containment)
 
 QString ShellCorona::containmentPreviewPath(Plasma::Containment *containment) const
 {
-    const QString path = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/plasma/containmentpreviews/")
-        + QString::number(containment->id()) + QChar('-') + containment->activity() + QStringLiteral(".png");
+    const QString path = containmentPreviewDirectory() + containmentPreviewFileName(containment);
     if (QFile::exists(path)) {
         return path;
     } else {
@@ -2215,6 +2559,11 @@ ScreenPool *ShellCorona::screenPool() const
     return m_screenPool;
 }
 
+WindowManagerWatcher *ShellCorona::windowManagerWatcher() const
+{
+    return m_windowManagerWatcher;
+}
+
 QList<int> ShellCorona::screenIds() const
 {
     return m_screenPool->knownIds();
@@ -13,18 +13,25 @@
 
 #include <QDBusContext>
 #include <QDBusVariant>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
 #include <QSet>
+#include <QThreadPool>
 #include <QTimer>
 
 #include <KConfigWatcher>
 #include <KPackage/Package>
 
+#include <functional>
+#include <memory>
+
 class DesktopView;
 class PanelView;
 class QMenu;
 class QScreen;
 class ScreenPool;
 class StrutManager;
+class WindowManagerWatcher;
 class ShellContainmentConfig;
 
 namespace KActivities
@@ -84,6 +91,14 @@ public:
     QRegion _availableScreenRegion(int id) const;
     QRect _availableScreenRect(int id) const;
 
+    /**
+     * The available screen rects and regions changed. The cached ones are dropped right away,
+     * the change signals are emitted once for all changes of an event loop pass.
+     * A rect change implies a region change.
+     */
+    void scheduleAvailableScreenRectChange();
+    void scheduleAvailableScreenRegionChange();
+
     Q_INVOKABLE QStringList availableActivities() const;
 
     PanelView *panelView(Plasma::Containment *containment) const;
@@ -100,10 +115,22 @@ public:
      */
     Plasma::Containment *createContainmentForActivity(const QString &activity, int screenNum);
 
+    enum class DeferredContainments {
+        Needed, ///< The ones of the current activity and the connected screens
+        All, ///< Everything, for operations which work on the whole layout
+    };
+    /**
+     * Loads containments which were left unloaded at startup, everything
+     * which creates containments or works on the whole layout needs them first.
+     */
+    void loadDeferredContainments(DeferredContainments which = DeferredContainments::Needed);
+    void loadDeferredContainments(const QString &activity);
+
     KWayland::Client::PlasmaShell *waylandPlasmaShellInterface() const;
     KWayland::Client::PlasmaWindowManagement *waylandPlasmaWindowManagementInterface() const;
 
     ScreenPool *screenPool() const;
+    WindowManagerWatcher *windowManagerWatcher() const;
 
     QList<int> screenIds() const;
 
@@ -164,7 +191,12 @@ public Q_SLOTS:
     void activateLauncherMenu();
     QString color() const;
 
-    QByteArray dumpCurrentLayoutJS() const;
+    QByteArray dumpCurrentLayoutJS();
+
+    /**
+     * Milliseconds from the start of the shell until the first panel frame was shown, -1 if there was none yet
+     */
+    int firstPanelFrameTime() const;
 
     /**
      * loads the shell layout from a look and feel package,
@@ -251,6 +283,17 @@ private:
 #endif
 
     void insertContainment(const QString &activity, int screenNum, Plasma::Containment *containment);
+    void placeLoadedContainments(const QList<Plasma::Containment *> &containments);
+    void reportFirstPanelFrame();
+
+    /**
+     * Containments of activities which are not current and of screens which are not connected
+     * can be left unloaded at startup, see the deferInactiveContainments key in plasmashellrc.
+     * They stay in the layout config and are loaded as soon as they are needed.
+     */
+    bool isDeferrable(const KConfigGroup &containment) const;
+    void deferInactiveContainments(const KSharedConfig::Ptr &layout);
+    void loadDeferredContainmentsIf(const std::function<bool(const KConfigGroup &)> &filter);
 
     KSharedConfig::Ptr m_config;
     QString m_configPath;
@@ -270,11 +313,23 @@ private:
     KConfigGroup m_lnfDefaultsConfig;
     QList<Plasma::Containment *> m_waitingPanels;
     QHash<QString, QString> m_activityContainmentPlugins;
+    // Config of the containments which were not loaded yet
+    std::unique_ptr<KConfig> m_deferredContainments;
+    QElapsedTimer m_startupTimer;
+    // Containments whose preview is being grabbed or written, until when we wait for it
+    QHash<int, QDeadlineTimer> m_pendingContainmentPreviews;
+    // Hash of the last preview written for each containment, to skip identical ones
+    QHash<int, size_t> m_containmentPreviewHashes;
+    // Encodes and writes the previews, one at a time
+    QThreadPool m_containmentPreviewThreadPool;
+    int m_firstPanelFrameTime = -1;
     QAction *m_addPanelAction;
     std::unique_ptr<QMenu> m_addPanelsMenu;
     KPackage::Package m_lookAndFeelPackage;
 
     QTimer m_waitingPanelsTimer;
+    QTimer m_availableScreenChangeTimer;
+    bool m_availableScreenRectChangePending = false;
     QTimer m_appConfigSyncTimer;
 #ifndef NDEBUG
     QTimer m_invariantsTimer;
@@ -286,5 +341,6 @@ private:
     QString m_testModeLayout;
 
     StrutManager *m_strutManager;
+    WindowManagerWatcher *m_windowManagerWatcher;
     QPointer<ShellContainmentConfig> m_shellContainmentConfig;
 };
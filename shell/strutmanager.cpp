@@ -30,12 +30,29 @@ StrutManager::StrutManager(ShellCorona *plasmashellCorona)
         m_availableScreenRegions.remove(service);
         m_serviceWatcher->removeWatchedService(service);
 
-        Q_EMIT m_plasmashellCorona->availableScreenRectChanged();
+        m_plasmashellCorona->scheduleAvailableScreenRectChange();
     });
+
+    // Also catches whoever emits the change signals directly
+    connect(m_plasmashellCorona, &Plasma::Corona::availableScreenRectChanged, this, &StrutManager::invalidateCache);
+    connect(m_plasmashellCorona, &Plasma::Corona::availableScreenRegionChanged, this, &StrutManager::invalidateCache);
+    connect(m_plasmashellCorona, &Plasma::Corona::screenAdded, this, &StrutManager::invalidateCache);
+    connect(m_plasmashellCorona, &Plasma::Corona::screenRemoved, this, &StrutManager::invalidateCache);
+}
+
+void StrutManager::invalidateCache()
+{
+    m_rectCache.clear();
+    m_regionCache.clear();
 }
 
 QRect StrutManager::availableScreenRect(int id) const
 {
+    const auto it = m_rectCache.constFind(id);
+    if (it != m_rectCache.constEnd()) {
+        return *it;
+    }
+
     QRect r = m_plasmashellCorona->_availableScreenRect(id);
     QHash<int, QRect> service;
     foreach (service, m_availableScreenRects) {
@@ -43,6 +60,7 @@ QRect StrutManager::availableScreenRect(int id) const
             r &= service[id];
         }
     }
+    m_rectCache.insert(id, r);
     return r;
 }
 
@@ -53,6 +71,11 @@ QRect StrutManager::availableScreenRect(const QString &screenName) const
 
 QRegion StrutManager::availableScreenRegion(int id) const
 {
+    const auto it = m_regionCache.constFind(id);
+    if (it != m_regionCache.constEnd()) {
+        return *it;
+    }
+
     QRegion r = m_plasmashellCorona->_availableScreenRegion(id);
     QHash<int, QRegion> service;
     foreach (service, m_availableScreenRegions) {
@@ -60,6 +83,7 @@ QRegion StrutManager::availableScreenRegion(int id) const
             r &= service[id];
         }
     }
+    m_regionCache.insert(id, r);
     return r;
 }
 
@@ -70,7 +94,7 @@ void StrutManager::setAvailableScreenRect(const QString &service, const QString
         return;
     }
     m_availableScreenRects[service][id] = rect;
-    Q_EMIT m_plasmashellCorona->availableScreenRectChanged();
+    m_plasmashellCorona->scheduleAvailableScreenRectChange();
 }
 
 void StrutManager::setAvailableScreenRegion(const QString &service, const QString &screenName, const QList<QRect> &rects)
@@ -85,7 +109,7 @@ void StrutManager::setAvailableScreenRegion(const QString &service, const QStrin
         return;
     }
     m_availableScreenRegions[service][id] = region;
-    Q_EMIT m_plasmashellCorona->availableScreenRegionChanged();
+    m_plasmashellCorona->scheduleAvailableScreenRegionChange();
 }
 
 bool StrutManager::addWatchedService(const QString &service)
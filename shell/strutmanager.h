@@ -24,6 +24,11 @@ public:
     QRect availableScreenRect(int id) const;
     QRegion availableScreenRegion(int id) const;
 
+    /**
+     * Drops the cached rects and regions, to be called whenever a panel, screen or service changes them
+     */
+    void invalidateCache();
+
 public Q_SLOTS:
     QRect availableScreenRect(const QString &screenName) const;
 
@@ -38,4 +43,8 @@ private:
 
     QHash<const QString, QHash<int, QRect>> m_availableScreenRects;
     QHash<const QString, QHash<int, QRegion>> m_availableScreenRegions;
+
+    // By screen id, asked for a lot more often than they change
+    mutable QHash<int, QRect> m_rectCache;
+    mutable QHash<int, QRegion> m_regionCache;
 };
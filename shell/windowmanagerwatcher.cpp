@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "windowmanagerwatcher.h"
+
+#include <KWindowSystem>
+#include <QGuiApplication>
+#include <QTimer>
+
+#include <config-plasma.h>
+#if HAVE_X11
+#include <NETWM>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#include <private/qtx11extras_p.h>
+#else
+#include <QX11Info>
+#endif
+#include <xcb/xcb.h>
+#include <xcb/xcb_event.h>
+
+#include <cstring>
+
+#include "../c_ptr.h"
+#endif
+
+WindowManagerWatcher::WindowManagerWatcher(QObject *parent)
+    : QObject(parent)
+{
+#if HAVE_X11
+    if (KWindowSystem::isPlatformX11()) {
+        static const char atomName[] = "_NET_SUPPORTING_WM_CHECK";
+        xcb_connection_t *connection = QX11Info::connection();
+        const xcb_intern_atom_cookie_t cookie = xcb_intern_atom(connection, false, strlen(atomName), atomName);
+        UniqueCPointer<xcb_intern_atom_reply_t> reply(xcb_intern_atom_reply(connection, cookie, nullptr));
+        if (reply) {
+            m_supportingWmCheckAtom = reply->atom;
+        }
+        readName();
+        qGuiApp->installNativeEventFilter(this);
+    }
+#endif
+}
+
+QByteArray WindowManagerWatcher::name() const
+{
+    return m_name;
+}
+
+bool WindowManagerWatcher::isKWin() const
+{
+    return qstricmp(m_name.constData(), "KWin") == 0;
+}
+
+void WindowManagerWatcher::readName()
+{
+#if HAVE_X11
+    // a roundtrip, which is why this is only done when the window manager changes
+    NETRootInfo rootInfo(QX11Info::connection(), NET::Supported | NET::SupportingWMCheck);
+    const QByteArray name = rootInfo.wmName();
+    if (name != m_name) {
+        m_name = name;
+        Q_EMIT windowManagerChanged();
+    }
+#endif
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+bool WindowManagerWatcher::nativeEventFilter(const QByteArray &eventType, void *message, long int *result)
+#else
+bool WindowManagerWatcher::nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result)
+#endif
+{
+    Q_UNUSED(result);
+#if HAVE_X11
+    if (eventType[0] != 'x' || !m_supportingWmCheckAtom) {
+        return false;
+    }
+
+    auto *ev = static_cast<xcb_generic_event_t *>(message);
+    if (XCB_EVENT_RESPONSE_TYPE(ev) != XCB_PROPERTY_NOTIFY) {
+        return false;
+    }
+    auto *propertyEvent = reinterpret_cast<xcb_property_notify_event_t *>(ev);
+    if (propertyEvent->atom == m_supportingWmCheckAtom && propertyEvent->window == QX11Info::appRootWindow()) {
+        // The new window manager sets its name right after announcing itself
+        QTimer::singleShot(0, this, &WindowManagerWatcher::readName);
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,41 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QAbstractNativeEventFilter>
+#include <QByteArray>
+#include <QObject>
+
+/**
+ * Keeps track of the name of the running X11 window manager.
+ *
+ * It is read once and again only when another window manager takes over,
+ * which updates _NET_SUPPORTING_WM_CHECK on the root window.
+ */
+class WindowManagerWatcher : public QObject, public QAbstractNativeEventFilter
+{
+    Q_OBJECT
+public:
+    explicit WindowManagerWatcher(QObject *parent);
+
+    QByteArray name() const;
+    bool isKWin() const;
+
+Q_SIGNALS:
+    void windowManagerChanged();
+
+private:
+    void readName();
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) override;
+#else
+    bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
+#endif
+
+    QByteArray m_name;
+    uint m_supportingWmCheckAtom = 0;
+};
@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+#pragma once
+
+#include <QVector>
+
+// SSE2 and NEON kernels are built when the compiler targets them anyway. AVX2 kernels are
+// built with SIMD_TARGET_AVX2 on their own and may only run where isSupported() says so.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_SSE2
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_AVX2
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SIMD_NEON
+#endif
+
+/**
+ * Picks between the versions of a pixel loop for the vector instructions at hand.
+ *
+ * Code with vectorized kernels takes a Simd::Kernel, defaulting to Simd::best(),
+ * so that tests and benchmarks can run each kernel the build and the CPU support.
+ */
+namespace Simd
+{
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+inline bool isSupported(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Scalar:
+        return true;
+    case Kernel::Sse2:
+#if defined(SIMD_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    case Kernel::Avx2: {
+#if defined(SIMD_AVX2)
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+        return hasAvx2;
+#else
+        return false;
+#endif
+    }
+    case Kernel::Neon:
+#if defined(SIMD_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/**
+ * The widest kernel this build and the CPU can run
+ */
+inline Kernel best()
+{
+    for (Kernel kernel : {Kernel::Avx2, Kernel::Sse2, Kernel::Neon}) {
+        if (isSupported(kernel)) {
+            return kernel;
+        }
+    }
+    return Kernel::Scalar;
+}
+
+inline QVector<Kernel> supportedKernels()
+{
+    QVector<Kernel> kernels;
+    for (Kernel kernel : {Kernel::Scalar, Kernel::Sse2, Kernel::Avx2, Kernel::Neon}) {
+        if (isSupported(kernel)) {
+            kernels << kernel;
+        }
+    }
+    return kernels;
+}
+
+inline const char *name(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::Sse2:
+        return "sse2";
+    case Kernel::Avx2:
+        return "avx2";
+    case Kernel::Neon:
+        return "neon";
+    }
+    return "";
+}
+}
@@ -14,12 +14,19 @@
 #include <QDBusConnection>
 #include <QDBusMessage>
 #include <QDBusPendingCall>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QFuture>
 #include <QGuiApplication>
 #include <QLibrary>
 #include <QPluginLoader>
+#include <QStandardPaths>
 #include <QTimer>
+#include <QtConcurrent>
 
 #include <KAboutData>
 #include <KConfig>
@@ -27,6 +34,10 @@
 #include <KLocalizedString>
 #include <kworkspace.h>
 
+#include "startuptracer.h"
+
+#include <algorithm>
+
 static int ready[2];
 static bool startup = false;
 
@@ -48,7 +59,13 @@ static void waitForReady()
     close(ready[0]);
 }
 
-bool KCMInit::runModule(const KPluginMetaData &data)
+static qint64 modificationTime(const KPluginMetaData &data)
+{
+    // Follows the symlinks in plasma/kcminit to the actual KCM
+    return QFileInfo(data.fileName()).lastModified().toMSecsSinceEpoch();
+}
+
+KCMInit::InitResult KCMInit::runModule(const KPluginMetaData &data, qint64 *duration)
 {
     QString path = QPluginLoader(data.fileName()).fileName();
 
@@ -56,17 +73,54 @@ bool KCMInit::runModule(const KPluginMetaData &data)
     QFunctionPointer init = QLibrary::resolve(path, "kcminit");
     if (!init) {
         qWarning() << "Module" << data.fileName() << "does not actually have a kcminit function";
-        return false;
+        return InitResult::NoInitFunction;
     }
 
     // initialize the module
     qDebug() << "Initializing " << data.fileName();
+    const StartupTraceScope trace(data.pluginId(), QStringLiteral("kcminit"));
+    QElapsedTimer timer;
+    timer.start();
     init();
-    return true;
+    *duration = timer.elapsed();
+    return InitResult::Initialized;
+}
+
+bool KCMInit::knownWithoutInit(const KPluginMetaData &data) const
+{
+    const KConfigGroup group = m_symbolCache->group(data.fileName());
+    return !group.readEntry("HasInit", true) && group.readEntry("Modified", qint64(0)) == modificationTime(data);
+}
+
+void KCMInit::recordResult(const KPluginMetaData &data, InitResult result)
+{
+    KConfigGroup group = m_symbolCache->group(data.fileName());
+    if (result == InitResult::Initialized) {
+        // Having an init function is the common case, only remember the ones that don't
+        if (group.exists()) {
+            group.deleteGroup();
+        }
+        return;
+    }
+    group.writeEntry("HasInit", false);
+    group.writeEntry("Modified", modificationTime(data));
 }
 
 void KCMInit::runModules(int phase)
 {
+    const StartupTraceScope trace(phase == -1 ? QStringLiteral("kcminit") : QStringLiteral("kcminit phase %1").arg(phase));
+
+    struct Module {
+        KPluginMetaData data;
+        InitResult result = InitResult::NoInitFunction;
+        qint64 duration = 0;
+        // Only set for the modules that run concurrently
+        QFuture<void> future;
+    };
+    // Reserved up front, the concurrent modules write their results into it
+    std::vector<Module> modules;
+    modules.reserve(m_list.size());
+
     for (const KPluginMetaData &data : qAsConst(m_list)) {
         // see ksmserver's README for the description of the phases
         int libphase = data.value(QStringLiteral("X-KDE-Init-Phase"), 1);
@@ -78,16 +132,57 @@ void KCMInit::runModules(int phase)
         if (phase != -1 && libphase != phase)
             continue;
 
-        // try to load the library
-        if (!m_alreadyInitialized.contains(data.pluginId())) {
-            runModule(data);
-            m_alreadyInitialized.append(data.pluginId());
+        if (m_alreadyInitialized.contains(data.pluginId())) {
+            continue;
+        }
+        m_alreadyInitialized.append(data.pluginId());
+
+        if (knownWithoutInit(data)) {
+            qDebug() << "Skipping" << data.fileName() << "which has no kcminit function";
+            continue;
+        }
+
+        modules.push_back({data});
+        Module &module = modules.back();
+        // Modules have to opt in to be run off the main thread, most of them need the QGuiApplication or X connection
+        if (data.value(QStringLiteral("X-KDE-Init-ThreadSafe"), false)) {
+            module.future = QtConcurrent::run([this, &module] {
+                module.result = runModule(module.data, &module.duration);
+            });
+        } else {
+            module.result = runModule(data, &module.duration);
         }
     }
+
+    QVector<QPair<QString, qint64>> durations;
+    for (Module &module : modules) {
+        module.future.waitForFinished();
+        if (module.result == InitResult::Initialized) {
+            durations.append({module.data.pluginId(), module.duration});
+        }
+        recordResult(module.data, module.result);
+    }
+
+    if (m_symbolCache->isDirty()) {
+        QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+        m_symbolCache->sync();
+    }
+
+    // kcminit is gone right after the startup, the timings are kept in the log and the startup trace
+    std::sort(durations.begin(), durations.end(), [](const QPair<QString, qint64> &a, const QPair<QString, qint64> &b) {
+        return a.second > b.second;
+    });
+    for (const auto &duration : std::as_const(durations)) {
+        qInfo() << "Initialized" << duration.first << "in" << duration.second << "ms";
+    }
 }
 
 KCMInit::KCMInit(const QCommandLineParser &args)
 {
+    // The cache directory is only created once there is something to write, see runModules()
+    m_symbolCache = std::make_unique<KConfig>(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/kcminit-modules"),
+                                              KConfig::SimpleConfig);
+
     if (args.isSet(QStringLiteral("list"))) {
         m_list = KPluginMetaData::findPlugins(QStringLiteral("plasma/kcminit"));
         for (const KPluginMetaData &data : qAsConst(m_list)) {
@@ -116,6 +211,7 @@ KCMInit::KCMInit(const QCommandLineParser &args)
 
     if (startup) {
         runModules(0);
+        StartupTracer::self().exportTrace(StartupTracer::ExportMode::Merge);
         // Tell KSplash that KCMInit has started
         QDBusMessage ksplashProgressMessage = QDBusMessage::createMethodCall(QStringLiteral("org.kde.KSplash"),
                                                                              QStringLiteral("/KSplash"),
@@ -143,6 +239,7 @@ KCMInit::~KCMInit()
 void KCMInit::runPhase1()
 {
     runModules(1);
+    StartupTracer::self().exportTrace(StartupTracer::ExportMode::Merge);
     qApp->exit(0);
 }
 
@@ -9,6 +9,10 @@
 #include <KPluginMetaData>
 #include <QCommandLineParser>
 
+#include <memory>
+
+class KConfig;
+
 class KCMInit : public QObject
 {
     Q_OBJECT
@@ -21,8 +25,18 @@ public:
     ~KCMInit() override;
 
 private:
-    bool runModule(const KPluginMetaData &data);
+    enum class InitResult {
+        Initialized,
+        NoInitFunction,
+    };
+    // Stores how long the kcminit function took in @p duration, in milliseconds. Called from the thread pool for thread-safe modules
+    InitResult runModule(const KPluginMetaData &data, qint64 *duration);
     void runModules(int phase);
+    bool knownWithoutInit(const KPluginMetaData &data) const;
+    void recordResult(const KPluginMetaData &data, InitResult result);
+
     QVector<KPluginMetaData> m_list;
     QStringList m_alreadyInitialized;
+    // Remembers which plugins lack a kcminit function, so we don't load them on every login
+    std::unique_ptr<KConfig> m_symbolCache;
 };
@@ -76,60 +76,12 @@ void AutoStart::loadAutoStartList()
         item.service = *it;
         item.name = extractName(it.key());
         item.startAfter = config.startAfter();
+        item.waitForDBusService = config.waitForDBusService();
         item.phase = qMax(PlasmaAutostart::BaseDesktop, config.startPhase());
         m_startList.append(item);
     }
 }
 
-QString AutoStart::startService()
-{
-    if (m_startList.isEmpty()) {
-        return QString();
-    }
-
-    while (!m_started.isEmpty()) {
-        // Check for items that depend on previously started items
-        QString lastItem = m_started[0];
-        QMutableVectorIterator<AutoStartItem> it(m_startList);
-        while (it.hasNext()) {
-            const auto &item = it.next();
-            if (item.phase == m_phase && item.startAfter == lastItem) {
-                m_started.prepend(item.name);
-                QString service = item.service;
-                it.remove();
-                return service;
-            }
-        }
-        m_started.removeFirst();
-    }
-
-    // Check for items that don't depend on anything
-    QMutableVectorIterator<AutoStartItem> it(m_startList);
-    while (it.hasNext()) {
-        const auto &item = it.next();
-        if (item.phase == m_phase && item.startAfter.isEmpty()) {
-            m_started.prepend(item.name);
-            QString service = item.service;
-            it.remove();
-            return service;
-        }
-    }
-
-    // Just start something in this phase
-    it = m_startList;
-    while (it.hasNext()) {
-        const auto &item = it.next();
-        if (item.phase == m_phase) {
-            m_started.prepend(item.name);
-            QString service = item.service;
-            it.remove();
-            return service;
-        }
-    }
-
-    return QString();
-}
-
 QVector<AutoStartItem> AutoStart::startList() const
 {
     QVector<AutoStartItem> ret;
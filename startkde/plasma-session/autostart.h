@@ -15,6 +15,7 @@ public:
     QString name;
     QString service;
     QString startAfter;
+    QString waitForDBusService;
     int phase;
 };
 
@@ -24,7 +25,6 @@ public:
     AutoStart();
     ~AutoStart();
 
-    QString startService();
     void setPhase(int phase);
     void setPhaseDone();
     int phase() const
@@ -40,7 +40,6 @@ public:
 private:
     void loadAutoStartList();
     QVector<AutoStartItem> m_startList;
-    QStringList m_started;
     int m_phase;
     bool m_phasedone;
 };
@@ -18,11 +18,12 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "kcminit_interface.h"
 #include "kded_interface.h"
 #include "ksmserver_interface.h"
 
-#include <KCompositeJob>
 #include <KConfig>
 #include <KConfigGroup>
 #include <KIO/DesktopExecParser>
@@ -30,8 +31,10 @@
 #include <KService>
 
 #include <QDBusConnection>
+#include <QDBusConnectionInterface>
 #include <QDBusMessage>
 #include <QDBusPendingCall>
+#include <QDBusServiceWatcher>
 #include <QDir>
 #include <QProcess>
 #include <QStandardPaths>
@@ -42,84 +45,129 @@
 
 #include "../config-startplasma.h"
 #include "startplasma.h"
+#include "startuptracer.h"
 
-class Phase : public KCompositeJob
+static QString jobName(const KJob *job)
 {
-    Q_OBJECT
-public:
-    Phase(const AutoStart &autostart, QObject *parent)
-        : KCompositeJob(parent)
-        , m_autostart(autostart)
-    {
-    }
+    return job->objectName().isEmpty() ? QString::fromLatin1(job->metaObject()->className()) : job->objectName();
+}
 
-    bool addSubjob(KJob *job) override
-    {
-        bool rc = KCompositeJob::addSubjob(job);
-        job->start();
-        return rc;
+// Records the time from now until the job finishes
+static void traceJob(KJob *job, const QString &category)
+{
+    const int span = StartupTracer::self().begin(jobName(job), category);
+    QObject::connect(job, &KJob::finished, job, [span] {
+        StartupTracer::self().end(span);
+    });
+}
+
+// How long autostart entries wait for the D-Bus service they depend on
+static constexpr int s_dbusWaitTimeout = 10 * 1000;
+
+StartupGraph::StartupGraph(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void StartupGraph::addJob(KJob *job, const QVector<KJob *> &dependencies)
+{
+    if (!job) {
+        return;
     }
 
-    void slotResult(KJob *job) override
-    {
-        KCompositeJob::slotResult(job);
-        if (!hasSubjobs()) {
-            emitResult();
+    Node node;
+    node.job = job;
+    node.name = jobName(job);
+    for (KJob *dependency : dependencies) {
+        if (!dependency) {
+            continue;
+        }
+        const auto it = m_indexes.constFind(dependency);
+        Q_ASSERT_X(it != m_indexes.constEnd(), "StartupGraph::addJob", "dependencies have to be added first");
+        if (it != m_indexes.constEnd()) {
+            node.dependencies << *it;
         }
     }
 
-protected:
-    const AutoStart m_autostart;
-};
+    const int index = m_nodes.size();
+    m_indexes.insert(job, index);
+    m_nodes.append(node);
+    connect(job, &KJob::finished, this, [this, index] {
+        jobFinished(index);
+    });
+}
 
-class StartupPhase0 : public Phase
+void StartupGraph::start()
 {
-    Q_OBJECT
-public:
-    StartupPhase0(const AutoStart &autostart, QObject *parent)
-        : Phase(autostart, parent)
-    {
+    m_clock.start();
+    m_unfinished = m_nodes.size();
+    if (m_nodes.isEmpty()) {
+        QTimer::singleShot(0, this, &StartupGraph::finished);
+        return;
     }
-    void start() override
-    {
-        qCDebug(PLASMA_SESSION) << "Phase 0";
-        addSubjob(new AutoStartAppsJob(m_autostart, 0));
-        addSubjob(new KCMInitJob());
-        addSubjob(new SleepJob());
+    startReadyJobs();
+}
+
+void StartupGraph::startReadyJobs()
+{
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].started) {
+            continue;
+        }
+        const bool ready = std::all_of(m_nodes[i].dependencies.cbegin(), m_nodes[i].dependencies.cend(), [this](int dependency) {
+            return m_nodes[dependency].finished;
+        });
+        if (!ready) {
+            continue;
+        }
+        // Mark first, jobs may finish synchronously and get us called again
+        m_nodes[i].started = true;
+        m_nodes[i].span = StartupTracer::self().begin(m_nodes[i].name, QStringLiteral("job"));
+        qCDebug(PLASMA_SESSION) << "Starting" << m_nodes[i].name << "after" << m_clock.elapsed() << "ms";
+        m_nodes[i].job->start();
     }
-};
+}
 
-class StartupPhase1 : public Phase
+void StartupGraph::jobFinished(int index)
 {
-    Q_OBJECT
-public:
-    StartupPhase1(const AutoStart &autostart, QObject *parent)
-        : Phase(autostart, parent)
-    {
+    Node &node = m_nodes[index];
+    if (node.finished) {
+        return;
     }
-    void start() override
-    {
-        qCDebug(PLASMA_SESSION) << "Phase 1";
-        addSubjob(new AutoStartAppsJob(m_autostart, 1));
+    node.finished = true;
+    node.finishedAt = m_clock.elapsed();
+    StartupTracer::self().end(node.span);
+
+    // The dependency which finished last is what held this job back
+    for (int dependency : std::as_const(node.dependencies)) {
+        if (node.criticalPredecessor < 0 || m_nodes[dependency].finishedAt > m_nodes[node.criticalPredecessor].finishedAt) {
+            node.criticalPredecessor = dependency;
+        }
+    }
+    if (m_lastFinished < 0 || node.finishedAt >= m_nodes[m_lastFinished].finishedAt) {
+        m_lastFinished = index;
     }
-};
 
-class StartupPhase2 : public Phase
-{
-    Q_OBJECT
-public:
-    StartupPhase2(const AutoStart &autostart, QObject *parent)
-        : Phase(autostart, parent)
-    {
+    if (--m_unfinished == 0) {
+        Q_EMIT finished();
+        return;
     }
+    startReadyJobs();
+}
 
-    void start() override
-    {
-        qCDebug(PLASMA_SESSION) << "Phase 2";
-        addSubjob(new AutoStartAppsJob(m_autostart, 2));
-        addSubjob(new KDEDInitJob());
+QStringList StartupGraph::criticalPath() const
+{
+    QStringList path;
+    for (int index = m_lastFinished; index >= 0; index = m_nodes[index].criticalPredecessor) {
+        path.prepend(m_nodes[index].name);
     }
-};
+    return path;
+}
+
+qint64 StartupGraph::elapsed() const
+{
+    return m_lastFinished < 0 ? 0 : m_nodes[m_lastFinished].finishedAt;
+}
 
 SleepJob::SleepJob()
 {
@@ -139,6 +187,7 @@ Startup::Startup(QObject *parent)
 {
     Q_ASSERT(!s_self);
     s_self = this;
+    m_startupSpan = StartupTracer::self().begin(QStringLiteral("plasma_session"));
     new StartupAdaptor(this);
     QDBusConnection::sessionBus().registerObject(QStringLiteral("/Startup"), QStringLiteral("org.kde.Startup"), this);
     QDBusConnection::sessionBus().registerService(QStringLiteral("org.kde.Startup"));
@@ -164,6 +213,7 @@ Startup::Startup(QObject *parent)
         // This must block until started as it sets the WAYLAND_DISPLAY/DISPLAY env variables needed for the rest of the boot
         // fortunately it's very fast as it's just starting a wrapper
         StartServiceJob kwinWaylandJob(QStringLiteral("kwin_wayland_wrapper"), {QStringLiteral("--xwayland")}, QStringLiteral("org.kde.KWinWrapper"));
+        traceJob(&kwinWaylandJob, QStringLiteral("job"));
         kwinWaylandJob.exec();
         // kslpash is only launched in plasma-session from the wayland mode, for X it's in startplasma-x11
 
@@ -175,35 +225,51 @@ Startup::Startup(QObject *parent)
         }
     }
 
-    // Keep for KF5; remove in KF6 (KInit will be gone then)
-    QProcess::execute(QStringLiteral(CMAKE_INSTALL_FULL_LIBEXECDIR_KF5 "/start_kdeinit_wrapper"), QStringList());
+    {
+        const StartupTraceScope trace(QStringLiteral("start_kdeinit_wrapper"), QStringLiteral("job"));
+        // Keep for KF5; remove in KF6 (KInit will be gone then)
+        QProcess::execute(QStringLiteral(CMAKE_INSTALL_FULL_LIBEXECDIR_KF5 "/start_kdeinit_wrapper"), QStringList());
+    }
 
-    KJob *phase1 = nullptr;
     m_lock.reset(new QEventLoopLocker);
 
-    const QVector<KJob *> sequence = {
-        new StartProcessJob(QStringLiteral("kcminit_startup"), {}),
-        new StartServiceJob(QStringLiteral("kded5"), {}, QStringLiteral("org.kde.kded5"), {}),
-        x11WindowManagerJob,
-        new StartServiceJob(QStringLiteral("ksmserver"), QCoreApplication::instance()->arguments().mid(1), QStringLiteral("org.kde.ksmserver")),
-        new StartupPhase0(autostart, this),
-        phase1 = new StartupPhase1(autostart, this),
-        new RestoreSessionJob(),
-        new StartupPhase2(autostart, this),
-    };
-    KJob *last = nullptr;
-    for (KJob *job : sequence) {
-        if (!job) {
-            continue;
-        }
-        if (last) {
-            connect(last, &KJob::finished, job, &KJob::start);
-        }
-        last = job;
-    }
-
-    connect(sequence.last(), &KJob::finished, this, &Startup::finishStartup);
-    sequence.first()->start();
+    auto kcminitJob = new StartProcessJob(QStringLiteral("kcminit_startup"), {});
+    auto kdedJob = new StartServiceJob(QStringLiteral("kded5"), {}, QStringLiteral("org.kde.kded5"), {});
+    auto ksmserverJob =
+        new StartServiceJob(QStringLiteral("ksmserver"), QCoreApplication::instance()->arguments().mid(1), QStringLiteral("org.kde.ksmserver"));
+    auto autoStart0Job = new AutoStartAppsJob(autostart, 0);
+    auto kcminitPhase1Job = new KCMInitJob();
+    auto sleepJob = new SleepJob();
+    auto autoStart1Job = new AutoStartAppsJob(autostart, 1);
+    auto restoreSessionJob = new RestoreSessionJob();
+    auto autoStart2Job = new AutoStartAppsJob(autostart, 2);
+    auto kdedPhase2Job = new KDEDInitJob();
+
+    // Only real dependencies are expressed here, everything else runs concurrently:
+    // - the window manager needs the settings kcminit applies in its phase 0
+    // - the session manager needs the window manager and kded, like it always had them before it
+    // - kcminit only serves its phase 1 once it was handed off, which the session manager waits for as well
+    // - each autostart phase builds on the previous one
+    // - restoring the session and the last phase need the desktop services from phase 1
+    auto graph = new StartupGraph(this);
+    graph->addJob(kcminitJob);
+    graph->addJob(kdedJob);
+    graph->addJob(x11WindowManagerJob, {kcminitJob});
+    graph->addJob(ksmserverJob, {kcminitJob, kdedJob, x11WindowManagerJob});
+    graph->addJob(autoStart0Job, {ksmserverJob});
+    graph->addJob(kcminitPhase1Job, {ksmserverJob});
+    graph->addJob(sleepJob, {ksmserverJob});
+    graph->addJob(autoStart1Job, {autoStart0Job, kcminitPhase1Job, sleepJob});
+    graph->addJob(restoreSessionJob, {autoStart1Job});
+    graph->addJob(autoStart2Job, {autoStart1Job});
+    graph->addJob(kdedPhase2Job, {autoStart1Job});
+
+    connect(graph, &StartupGraph::finished, this, [this, graph] {
+        m_criticalPath = QStringLiteral("%1 ms: %2").arg(graph->elapsed()).arg(graph->criticalPath().join(QLatin1String(" -> ")));
+        qCInfo(PLASMA_SESSION) << "Startup critical path" << m_criticalPath;
+        finishStartup();
+    });
+    graph->start();
 
     // app will be closed when all KJobs finish thanks to the QEventLoopLocker in each KJob
 }
@@ -225,7 +291,22 @@ void Startup::finishStartup()
 
     playStartupSound(this);
     new SessionTrack(m_processes);
-    deleteLater();
+
+    StartupTracer::self().end(m_startupSpan);
+    StartupTracer::self().exportTrace(StartupTracer::ExportMode::Merge);
+    qCInfo(PLASMA_SESSION).noquote() << "Startup finished, trace written to" << StartupTracer::traceFilePath() << '\n' << startupSummary();
+
+    // Stay around for startupSummary(), SessionTrack decides from now on when we quit
+    m_lock.reset();
+}
+
+QString Startup::startupSummary() const
+{
+    QString summary = StartupTracer::self().summary();
+    if (!m_criticalPath.isEmpty()) {
+        summary += QLatin1String("critical path: ") + m_criticalPath + QLatin1Char('\n');
+    }
+    return summary;
 }
 
 void Startup::updateLaunchEnv(const QString &key, const QString &value)
@@ -241,6 +322,11 @@ bool Startup::startDetached(const QString &program, const QStringList &args)
     return startDetached(p);
 }
 
+void Startup::trackProcess(QProcess *process)
+{
+    m_processes << process;
+}
+
 bool Startup::startDetached(QProcess *process)
 {
     process->setProcessChannelMode(QProcess::ForwardedChannels);
@@ -309,36 +395,143 @@ void RestoreSessionJob::start()
 AutoStartAppsJob::AutoStartAppsJob(const AutoStart &autostart, int phase)
     : m_autoStart(autostart)
 {
+    setObjectName(QStringLiteral("AutoStartAppsJob phase %1").arg(phase));
     m_autoStart.setPhase(phase);
 }
 
 void AutoStartAppsJob::start()
 {
-    qCDebug(PLASMA_SESSION);
-
-    QTimer::singleShot(0, this, [=]() {
-        do {
-            QString serviceName = m_autoStart.startService();
-            if (serviceName.isEmpty()) {
-                // Done
-                if (!m_autoStart.phaseDone()) {
-                    m_autoStart.setPhaseDone();
-                }
-                emitResult();
-                return;
-            }
-            KService service(serviceName);
-            auto arguments = KIO::DesktopExecParser(service, QList<QUrl>()).resultingArguments();
-            if (arguments.isEmpty()) {
-                qCWarning(PLASMA_SESSION) << "failed to parse" << serviceName << "for autostart";
-                continue;
-            }
-            qCInfo(PLASMA_SESSION) << "Starting autostart service " << serviceName << arguments;
-            auto program = arguments.takeFirst();
-            if (!Startup::self()->startDetached(program, arguments))
-                qCWarning(PLASMA_SESSION) << "could not start" << serviceName << ":" << program << arguments;
-        } while (true);
+    qCDebug(PLASMA_SESSION) << "Autostart phase" << m_autoStart.phase();
+
+    m_pending = m_autoStart.startList();
+
+    for (const AutoStartItem &item : std::as_const(m_pending)) {
+        if (item.waitForDBusService.isEmpty() || m_registeredServices.contains(item.waitForDBusService)) {
+            continue;
+        }
+        if (!m_serviceWatcher) {
+            m_serviceWatcher = new QDBusServiceWatcher(this);
+            m_serviceWatcher->setConnection(QDBusConnection::sessionBus());
+            m_serviceWatcher->setWatchMode(QDBusServiceWatcher::WatchForRegistration);
+            connect(m_serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, [this](const QString &service) {
+                m_registeredServices.insert(service);
+                launchReady();
+            });
+        }
+        m_serviceWatcher->addWatchedService(item.waitForDBusService);
+        if (QDBusConnection::sessionBus().interface()->isServiceRegistered(item.waitForDBusService)) {
+            m_registeredServices.insert(item.waitForDBusService);
+        }
+    }
+
+    if (m_serviceWatcher) {
+        m_dbusWaitTimer.setSingleShot(true);
+        m_dbusWaitTimer.setInterval(s_dbusWaitTimeout);
+        connect(&m_dbusWaitTimer, &QTimer::timeout, this, [this] {
+            qCWarning(PLASMA_SESSION) << "Timed out waiting for D-Bus services" << m_serviceWatcher->watchedServices() << "starting the remaining autostart entries";
+            launchReady();
+        });
+        m_dbusWaitTimer.start();
+    }
+
+    QTimer::singleShot(0, this, &AutoStartAppsJob::launchReady);
+}
+
+bool AutoStartAppsJob::isReady(const AutoStartItem &item) const
+{
+    if (!item.startAfter.isEmpty()) {
+        if (m_launching.contains(item.startAfter)) {
+            return false;
+        }
+        // Entries of other phases have been taken care of already
+        const bool predecessorPending = std::any_of(m_pending.cbegin(), m_pending.cend(), [&item](const AutoStartItem &other) {
+            return other.name == item.startAfter;
+        });
+        if (predecessorPending) {
+            return false;
+        }
+    }
+
+    if (!item.waitForDBusService.isEmpty() && m_dbusWaitTimer.isActive() && !m_registeredServices.contains(item.waitForDBusService)) {
+        return false;
+    }
+
+    return true;
+}
+
+void AutoStartAppsJob::launchReady()
+{
+    if (m_finished) {
+        return;
+    }
+
+    for (int i = 0; i < m_pending.size();) {
+        if (!isReady(m_pending.at(i))) {
+            ++i;
+            continue;
+        }
+        launch(m_pending.takeAt(i));
+        // Entries ordered after one that could not even be parsed may have become ready
+        i = 0;
+    }
+
+    if (m_launching.isEmpty() && !m_pending.isEmpty() && !m_dbusWaitTimer.isActive()) {
+        // Nothing will ever unblock the rest, their X-KDE-autostart-after entries form a cycle
+        qCWarning(PLASMA_SESSION) << "Autostart entries depend on each other, starting" << m_pending.constFirst().name << "anyway";
+        launch(m_pending.takeFirst());
+        QMetaObject::invokeMethod(this, &AutoStartAppsJob::launchReady, Qt::QueuedConnection);
+        return;
+    }
+
+    if (m_pending.isEmpty() && m_launching.isEmpty()) {
+        m_finished = true;
+        m_autoStart.setPhaseDone();
+        emitResult();
+    }
+}
+
+void AutoStartAppsJob::launch(const AutoStartItem &item)
+{
+    KService service(item.service);
+    auto arguments = KIO::DesktopExecParser(service, QList<QUrl>()).resultingArguments();
+    if (arguments.isEmpty()) {
+        qCWarning(PLASMA_SESSION) << "failed to parse" << item.service << "for autostart";
+        return;
+    }
+    qCInfo(PLASMA_SESSION) << "Starting autostart service " << item.service << arguments;
+
+    auto process = new QProcess;
+    process->setProgram(arguments.takeFirst());
+    process->setArguments(arguments);
+    process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+    const QString name = item.name;
+    // Only covers forking and executing the entry, applications do not report when they are ready
+    const int span = StartupTracer::self().begin(name, QStringLiteral("autostart launch"));
+    m_launching.insert(name);
+
+    connect(process, &QProcess::started, this, [this, process, name, span] {
+        StartupTracer::self().end(span);
+        Startup::self()->trackProcess(process);
+        launchFinished(name);
     });
+    connect(process, &QProcess::errorOccurred, this, [this, process, name, span](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart) {
+            return;
+        }
+        StartupTracer::self().end(span);
+        qCWarning(PLASMA_SESSION) << "could not start" << name << ":" << process->program() << process->arguments();
+        process->deleteLater();
+        launchFinished(name);
+    });
+    process->start();
+}
+
+void AutoStartAppsJob::launchFinished(const QString &name)
+{
+    m_launching.remove(name);
+    // Queued, QProcess may report failures from within start()
+    QMetaObject::invokeMethod(this, &AutoStartAppsJob::launchReady, Qt::QueuedConnection);
 }
 
 StartServiceJob::StartServiceJob(const QString &process, const QStringList &args, const QString &serviceId, const QProcessEnvironment &additionalEnv)
@@ -347,6 +540,7 @@ StartServiceJob::StartServiceJob(const QString &process, const QStringList &args
     , m_serviceId(serviceId)
     , m_additionalEnv(additionalEnv)
 {
+    setObjectName(process);
     m_process->setProgram(process);
     m_process->setArguments(args);
 
@@ -380,6 +574,7 @@ StartProcessJob::StartProcessJob(const QString &process, const QStringList &args
     : KJob()
     , m_process(new QProcess(this))
 {
+    setObjectName(process);
     m_process->setProgram(process);
     m_process->setArguments(args);
     m_process->setProcessChannelMode(QProcess::ForwardedChannels);
@@ -399,5 +594,3 @@ void StartProcessJob::start()
 
     m_process->start();
 }
-
-#include "startup.moc"
@@ -9,12 +9,18 @@
 #pragma once
 
 #include <KJob>
+#include <QElapsedTimer>
 #include <QEventLoopLocker>
+#include <QHash>
 #include <QObject>
 #include <QProcessEnvironment>
+#include <QSet>
+#include <QTimer>
 
 #include "autostart.h"
 
+class QDBusServiceWatcher;
+
 class Startup : public QObject
 {
     Q_OBJECT
@@ -31,20 +37,79 @@ public:
 
     bool startDetached(const QString &program, const QStringList &args);
     bool startDetached(QProcess *process);
+    /**
+     * Hands a process that was started elsewhere over to the session tracking
+     */
+    void trackProcess(QProcess *process);
 
 public Q_SLOTS:
     // alternatively we could drop this and have a rule that we /always/ launch everything through klauncher
     // need resolution from frameworks discussion on kdeinit
     void updateLaunchEnv(const QString &key, const QString &value);
 
+    /**
+     * How long the individual startup steps took so far, longest first
+     */
+    QString startupSummary() const;
+
 private:
     void autoStart(int phase);
 
+    int m_startupSpan = -1;
+    QString m_criticalPath;
     QVector<QProcess *> m_processes;
     std::unique_ptr<QEventLoopLocker> m_lock;
     static Startup *s_self;
 };
 
+/**
+ * Starts every job as soon as all the jobs it depends on have finished
+ * and measures the critical path through the graph.
+ */
+class StartupGraph : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StartupGraph(QObject *parent = nullptr);
+
+    /**
+     * Adds @p job, to be started once all of @p dependencies have finished.
+     * Dependencies have to be added first. Null jobs and dependencies are
+     * ignored, so optional jobs can be passed unconditionally.
+     */
+    void addJob(KJob *job, const QVector<KJob *> &dependencies = {});
+    void start();
+
+    /**
+     * The chain of jobs which determined the total duration, valid once finished() was emitted
+     */
+    QStringList criticalPath() const;
+    qint64 elapsed() const;
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    void startReadyJobs();
+    void jobFinished(int index);
+
+    struct Node {
+        KJob *job;
+        QString name;
+        QVector<int> dependencies;
+        bool started = false;
+        bool finished = false;
+        qint64 finishedAt = 0;
+        int criticalPredecessor = -1;
+        int span = -1;
+    };
+    QVector<Node> m_nodes;
+    QHash<KJob *, int> m_indexes;
+    QElapsedTimer m_clock;
+    int m_unfinished = 0;
+    int m_lastFinished = -1;
+};
+
 class SleepJob : public KJob
 {
     Q_OBJECT
@@ -69,6 +134,14 @@ public:
     void start() override;
 };
 
+/**
+ * Launches the autostart entries of one phase concurrently.
+ *
+ * An entry is held back until the entry named in its X-KDE-autostart-after
+ * has been launched, if that one is part of the same phase, and until the
+ * D-Bus service named in its X-KDE-autostart-wait-for-dbus is registered
+ * or s_dbusWaitTimeout passed.
+ */
 class AutoStartAppsJob : public KJob
 {
     Q_OBJECT
@@ -77,7 +150,19 @@ public:
     void start() override;
 
 private:
+    bool isReady(const AutoStartItem &item) const;
+    void launchReady();
+    void launch(const AutoStartItem &item);
+    void launchFinished(const QString &name);
+
     AutoStart m_autoStart;
+    QVector<AutoStartItem> m_pending;
+    // Entries whose process was started but did not report back yet
+    QSet<QString> m_launching;
+    QDBusServiceWatcher *m_serviceWatcher = nullptr;
+    QSet<QString> m_registeredServices;
+    QTimer m_dbusWaitTimer;
+    bool m_finished = false;
 };
 
 /**
@@ -202,3 +202,8 @@ QString PlasmaAutostart::startAfter() const
 {
     return df->desktopGroup().readEntry("X-KDE-autostart-after");
 }
+
+QString PlasmaAutostart::waitForDBusService() const
+{
+    return df->desktopGroup().readEntry("X-KDE-autostart-wait-for-dbus");
+}
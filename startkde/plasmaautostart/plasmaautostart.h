@@ -175,6 +175,13 @@ public:
      */
     QString startAfter() const;
 
+    /**
+     * Returns the D-Bus service name that has to be registered on the
+     * session bus before this service is autostarted, if any.
+     * @internal
+     */
+    QString waitForDBusService() const;
+
     /**
      * Checks whether autostart is allowed in the given environment,
      * depending on allowedEnvironments() and excludedEnvironments().
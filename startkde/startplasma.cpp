@@ -6,9 +6,13 @@
 
 #include <config-startplasma.h>
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QEventLoop>
 #include <QProcess>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QTextStream>
 
@@ -32,6 +36,7 @@
 #include <updatelaunchenvjob.h>
 
 #include "startplasma.h"
+#include "startuptracer.h"
 
 #include "../config-workspace.h"
 #include "../kcms/lookandfeel/lookandfeelmanager.h"
@@ -121,8 +126,99 @@ void setEnvironmentVariable(const QByteArray &name, const QByteArray &value)
     }
 }
 
+using EnvironmentDelta = QVector<QPair<QByteArray, QByteArray>>;
+
+static const quint32 s_environmentCacheVersion = 1;
+
+static bool environmentCacheEnabled()
+{
+    // Opt-in: scripts with side effects, e.g. starting an ssh-agent, must not be skipped
+    const auto config = KSharedConfig::openConfig(QStringLiteral("startkderc"), KConfig::NoGlobals);
+    return config->group(QStringLiteral("General")).readEntry("cacheEnvironmentScripts", false);
+}
+
+static QString environmentCacheFile()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/plasma-workspace/environment-scripts.cache");
+}
+
+// Identifies the outcome of sourcing the scripts: their contents and the environment they start from
+static QByteArray environmentCacheKey(const QStringList &files)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const QString &fileName : files) {
+        const QFileInfo info(fileName);
+        hash.addData(QFile::encodeName(info.absoluteFilePath()));
+        hash.addData(QByteArray::number(info.size()) + ':' + QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly)) {
+            hash.addData(&file);
+        }
+        hash.addData("\0", 1);
+    }
+
+    // Variables which differ on every login without influencing the scripts
+    static const QByteArrayList volatileVariables = {"DBUS_SESSION_BUS_ADDRESS",
+                                                     "SESSION_MANAGER",
+                                                     "DESKTOP_STARTUP_ID",
+                                                     "WINDOWPATH",
+                                                     "PWD",
+                                                     "OLDPWD",
+                                                     "INVOCATION_ID",
+                                                     "JOURNAL_STREAM",
+                                                     "MANAGERPID",
+                                                     "SYSTEMD_EXEC_PID"};
+    QStringList environment = QProcess::systemEnvironment();
+    environment.sort();
+    for (const QString &variable : std::as_const(environment)) {
+        const QByteArray entry = variable.toLocal8Bit();
+        const QByteArray name = entry.left(entry.indexOf('='));
+        if (isShellVariable(name) || isSessionVariable(name) || volatileVariables.contains(name)) {
+            continue;
+        }
+        hash.addData(entry);
+        hash.addData("\0", 1);
+    }
+    return hash.result();
+}
+
+static std::optional<EnvironmentDelta> readEnvironmentCache(const QByteArray &key)
+{
+    QFile file(environmentCacheFile());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QDataStream stream(&file);
+    quint32 version = 0;
+    QByteArray cachedKey;
+    EnvironmentDelta delta;
+    stream >> version >> cachedKey >> delta;
+    if (stream.status() != QDataStream::Ok || version != s_environmentCacheVersion || cachedKey != key) {
+        return std::nullopt;
+    }
+    return delta;
+}
+
+static void writeEnvironmentCache(const QByteArray &key, const EnvironmentDelta &delta)
+{
+    const QString fileName = environmentCacheFile();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(PLASMA_STARTUP) << "Could not write environment cache" << fileName << file.errorString();
+        return;
+    }
+    // The env scripts may well export tokens and passwords
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    QDataStream stream(&file);
+    stream << s_environmentCacheVersion << key << delta;
+    file.commit();
+}
+
 void sourceFiles(const QStringList &files)
 {
+    const StartupTraceScope trace(QStringLiteral("sourceFiles"));
     QStringList filteredFiles;
     std::copy_if(files.begin(), files.end(), std::back_inserter(filteredFiles), [](const QString &i) {
         return QFileInfo(i).isReadable();
@@ -131,6 +227,19 @@ void sourceFiles(const QStringList &files)
     if (filteredFiles.isEmpty())
         return;
 
+    const bool useCache = environmentCacheEnabled();
+    QByteArray cacheKey;
+    if (useCache) {
+        cacheKey = environmentCacheKey(filteredFiles);
+        if (const auto delta = readEnvironmentCache(cacheKey)) {
+            qCDebug(PLASMA_STARTUP) << "Environment scripts unchanged, applying the cached environment";
+            for (const auto &variable : *delta) {
+                setEnvironmentVariable(variable.first, variable.second);
+            }
+            return;
+        }
+    }
+
     filteredFiles.prepend(QStringLiteral(CMAKE_INSTALL_FULL_LIBEXECDIR "/plasma-sourceenv.sh"));
 
     QProcess p;
@@ -140,6 +249,7 @@ void sourceFiles(const QStringList &files)
     const auto fullEnv = p.readAllStandardOutput();
     auto envs = fullEnv.split('\0');
 
+    EnvironmentDelta delta;
     for (auto &env : envs) {
         const int idx = env.indexOf('=');
         if (Q_UNLIKELY(idx <= 0)) {
@@ -150,12 +260,22 @@ void sourceFiles(const QStringList &files)
         if (isShellVariable(name)) {
             continue;
         }
-        setEnvironmentVariable(name, env.mid(idx + 1));
+        const auto value = env.mid(idx + 1);
+        if (qgetenv(name) != value) {
+            delta.append({name, value});
+        }
+        setEnvironmentVariable(name, value);
+    }
+
+    // A failing script may have left the environment half done, don't make that permanent
+    if (useCache && p.exitStatus() == QProcess::NormalExit && p.exitCode() == 0) {
+        writeEnvironmentCache(cacheKey, delta);
     }
 }
 
 void createConfigDirectory()
 {
+    const StartupTraceScope trace(QStringLiteral("createConfigDirectory"));
     const QString configDir = QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation);
     if (!QDir().mkpath(configDir))
         out << "Could not create config directory XDG_CONFIG_HOME: " << configDir << '\n';
@@ -163,6 +283,7 @@ void createConfigDirectory()
 
 void runStartupConfig()
 {
+    const StartupTraceScope trace(QStringLiteral("runStartupConfig"));
     // export LC_* variables set by kcmshell5 formats into environment
     // so it can be picked up by QLocale and friends.
     KConfig config(QStringLiteral("plasma-localerc"));
@@ -190,6 +311,7 @@ void runStartupConfig()
 
 void setupCursor(bool wayland)
 {
+    const StartupTraceScope trace(QStringLiteral("setupCursor"));
     const KConfig cfg(QStringLiteral("kcminputrc"));
     const KConfigGroup inputCfg = cfg.group("Mouse");
 
@@ -216,6 +338,7 @@ void setupCursor(bool wayland)
 
 std::optional<QProcessEnvironment> getSystemdEnvironment()
 {
+    const StartupTraceScope trace(QStringLiteral("getSystemdEnvironment"));
     auto msg = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.systemd1"),
                                               QStringLiteral("/org/freedesktop/systemd1"),
                                               QStringLiteral("org.freedesktop.DBus.Properties"),
@@ -254,6 +377,7 @@ std::optional<QProcessEnvironment> getSystemdEnvironment()
 // But it won't work if plasma is not started by systemd.
 void importSystemdEnvrionment()
 {
+    const StartupTraceScope trace(QStringLiteral("importSystemdEnvironment"));
     const auto environment = getSystemdEnvironment();
     if (!environment) {
         return;
@@ -288,6 +412,7 @@ void importSystemdEnvrionment()
 
 void runEnvironmentScripts()
 {
+    const StartupTraceScope trace(QStringLiteral("runEnvironmentScripts"));
     QStringList scripts;
     auto locations = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation);
 
@@ -330,6 +455,7 @@ void runEnvironmentScripts()
 
 void setupPlasmaEnvironment()
 {
+    const StartupTraceScope trace(QStringLiteral("setupPlasmaEnvironment"));
     // Manually disable auto scaling because we are scaling above
     // otherwise apps that manually opt in for high DPI get auto scaled by the developer AND manually scaled by us
     qputenv("QT_AUTO_SCREEN_SCALE_FACTOR", "0");
@@ -390,6 +516,7 @@ void setupPlasmaEnvironment()
 
 void setupX11()
 {
+    const StartupTraceScope trace(QStringLiteral("setupX11"));
     //     Set a left cursor instead of the standard X11 "X" cursor, since I've heard
     //     from some users that they're confused and don't know what to do. This is
     //     especially necessary on slow machines, where starting KDE takes one or two
@@ -464,6 +591,7 @@ static void dropSessionVarsFromSystemdEnvironment()
 // In that case, the update in startplasma might be too late.
 bool syncDBusEnvironment()
 {
+    const StartupTraceScope trace(QStringLiteral("syncDBusEnvironment"));
     dropSessionVarsFromSystemdEnvironment();
 
     // At this point all environment variables are set, let's send it to the DBus session server to update the activation environment
@@ -475,6 +603,7 @@ static bool desktopLockedAtStart = false;
 
 QProcess *setupKSplash()
 {
+    const StartupTraceScope trace(QStringLiteral("setupKSplash"));
     const auto dlstr = qgetenv("DESKTOP_LOCKED");
     desktopLockedAtStart = dlstr == "true" || dlstr == "1";
     qunsetenv("DESKTOP_LOCKED"); // Don't want it in the environment
@@ -497,6 +626,7 @@ QProcess *setupKSplash()
 // This is independent of whether we use the Plasma systemd boot
 void resetSystemdFailedUnits()
 {
+    const StartupTraceScope trace(QStringLiteral("resetSystemdFailedUnits"));
     QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.systemd1"),
                                                           QStringLiteral("/org/freedesktop/systemd1"),
                                                           QStringLiteral("org.freedesktop.systemd1.Manager"),
@@ -508,6 +638,7 @@ void resetSystemdFailedUnits()
 // Needed for e.g. XDG autostart changes to become effective.
 void reloadSystemd()
 {
+    const StartupTraceScope trace(QStringLiteral("reloadSystemd"));
     QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.systemd1"),
                                                           QStringLiteral("/org/freedesktop/systemd1"),
                                                           QStringLiteral("org.freedesktop.systemd1.Manager"),
@@ -538,6 +669,7 @@ bool hasSystemdService(const QString &serviceName)
 
 bool useSystemdBoot()
 {
+    const StartupTraceScope trace(QStringLiteral("useSystemdBoot"));
     auto config = KSharedConfig::openConfig(QStringLiteral("startkderc"), KConfig::NoGlobals);
     const QString configValue = config->group(QStringLiteral("General")).readEntry("systemdBoot", QStringLiteral("true")).toLower();
 
@@ -577,6 +709,7 @@ void startKSplashViaSystemd()
 
 static void migrateUserScriptsAutostart()
 {
+    const StartupTraceScope trace(QStringLiteral("migrateUserScriptsAutostart"));
     QDir configLocation(QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation));
     QDir autostartScriptsLocation(configLocation.filePath(QStringLiteral("autostart-scripts")));
     if (!autostartScriptsLocation.exists()) {
@@ -667,8 +800,13 @@ bool startPlasmaSession(bool wayland)
     // Create .desktop files for the scripts in .config/autostart-scripts
     migrateUserScriptsAutostart();
 
+    const bool systemdBoot = useSystemdBoot();
+
+    // Hand our part of the startup trace over before the session continues it
+    StartupTracer::self().exportTrace(StartupTracer::ExportMode::Replace);
+
     std::unique_ptr<QProcess, KillBeforeDeleter> startPlasmaSession;
-    if (!useSystemdBoot()) {
+    if (!systemdBoot) {
         startPlasmaSession.reset(new QProcess);
         qCDebug(PLASMA_STARTUP) << "Using classic boot";
 
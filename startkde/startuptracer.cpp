@@ -0,0 +1,145 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "startuptracer.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <algorithm>
+#include <time.h>
+#include <unistd.h>
+
+#include "startuptracer_debug.h"
+
+StartupTracer &StartupTracer::self()
+{
+    static StartupTracer tracer;
+    return tracer;
+}
+
+qint64 StartupTracer::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+int StartupTracer::begin(const QString &name, const QString &category)
+{
+    // Spans of the main thread are shown on the track of the process
+    const auto app = QCoreApplication::instance();
+    const qint64 thread = app && QThread::currentThread() != app->thread() ? qint64(quintptr(QThread::currentThreadId())) : getpid();
+    QMutexLocker locker(&m_mutex);
+    m_spans.append({name, category, thread, now(), -1});
+    return m_spans.size() - 1;
+}
+
+void StartupTracer::end(int span)
+{
+    const qint64 timestamp = now();
+    QMutexLocker locker(&m_mutex);
+    if (span < 0 || span >= m_spans.size()) {
+        return;
+    }
+    m_spans[span].end = timestamp;
+    qCDebug(PLASMA_STARTUP_TRACER) << "Startup step" << m_spans[span].name << "took" << (timestamp - m_spans[span].start) / 1000 << "ms";
+}
+
+QString StartupTracer::summary() const
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_spans.isEmpty()) {
+        return QString();
+    }
+
+    const qint64 timestamp = now();
+    QVector<Span> spans = m_spans;
+    locker.unlock();
+    qint64 first = spans.constFirst().start;
+    qint64 last = 0;
+    for (Span &span : spans) {
+        if (span.end < 0) {
+            span.end = timestamp;
+        }
+        first = std::min(first, span.start);
+        last = std::max(last, span.end);
+    }
+    std::stable_sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+        return a.end - a.start > b.end - b.start;
+    });
+
+    QString ret = QStringLiteral("%1: %2 ms\n").arg(QCoreApplication::applicationName()).arg((last - first) / 1000);
+    for (const Span &span : std::as_const(spans)) {
+        ret += QStringLiteral("%1 ms\t%2%3\n")
+                   .arg((span.end - span.start) / 1000, 6)
+                   .arg(span.category.isEmpty() ? QString() : span.category + QLatin1String(": "), span.name);
+    }
+    return ret;
+}
+
+QString StartupTracer::traceFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation) + QLatin1String("/plasma-startup-trace.json");
+}
+
+bool StartupTracer::exportTrace(ExportMode mode) const
+{
+    const qint64 pid = getpid();
+    const qint64 timestamp = now();
+
+    // Keep what the other startup processes recorded, but not our own events of an earlier export
+    QJsonArray events;
+    QFile previous(traceFilePath());
+    if (mode == ExportMode::Merge && previous.open(QIODevice::ReadOnly)) {
+        const QJsonArray previousEvents = QJsonDocument::fromJson(previous.readAll()).object().value(QLatin1String("traceEvents")).toArray();
+        for (const QJsonValue &event : previousEvents) {
+            if (qint64(event.toObject().value(QLatin1String("pid")).toDouble()) != pid) {
+                events.append(event);
+            }
+        }
+        previous.close();
+    }
+
+    events.append(QJsonObject{
+        {QStringLiteral("name"), QStringLiteral("process_name")},
+        {QStringLiteral("ph"), QStringLiteral("M")},
+        {QStringLiteral("pid"), pid},
+        {QStringLiteral("args"), QJsonObject{{QStringLiteral("name"), QCoreApplication::applicationName()}}},
+    });
+    QMutexLocker locker(&m_mutex);
+    for (const Span &span : std::as_const(m_spans)) {
+        QJsonObject event{
+            {QStringLiteral("name"), span.name},
+            {QStringLiteral("cat"), span.category.isEmpty() ? QStringLiteral("startup") : span.category},
+            {QStringLiteral("ph"), QStringLiteral("X")},
+            {QStringLiteral("ts"), span.start},
+            {QStringLiteral("dur"), (span.end < 0 ? timestamp : span.end) - span.start},
+            {QStringLiteral("pid"), pid},
+            {QStringLiteral("tid"), span.thread},
+        };
+        if (span.end < 0) {
+            event.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("unfinished"), true}});
+        }
+        events.append(event);
+    }
+    locker.unlock();
+
+    QSaveFile file(traceFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(PLASMA_STARTUP_TRACER) << "Could not write startup trace" << file.fileName() << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{QStringLiteral("traceEvents"), events}, {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")}}).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * Records how long the individual steps of the session startup take.
+ *
+ * startplasma and plasma_session both feed their steps into the same trace file,
+ * $XDG_RUNTIME_DIR/plasma-startup-trace.json, which can be loaded into
+ * chrome://tracing or ui.perfetto.dev.
+ *
+ * Spans can be recorded from any thread.
+ */
+class StartupTracer
+{
+public:
+    static StartupTracer &self();
+
+    /**
+     * Starts a span and returns its handle for end()
+     */
+    int begin(const QString &name, const QString &category = QString());
+    void end(int span);
+
+    /**
+     * Human readable list of the recorded spans, longest first
+     */
+    QString summary() const;
+
+    enum class ExportMode {
+        Replace, ///< Start a new trace file, used by the first process of the startup
+        Merge, ///< Add to the events the previous startup processes exported
+    };
+
+    /**
+     * Writes the spans of this process to the trace file
+     */
+    bool exportTrace(ExportMode mode) const;
+    static QString traceFilePath();
+
+private:
+    StartupTracer() = default;
+
+    // CLOCK_MONOTONIC in microseconds, comparable between processes
+    static qint64 now();
+
+    struct Span {
+        QString name;
+        QString category;
+        qint64 thread;
+        qint64 start;
+        qint64 end;
+    };
+    mutable QMutex m_mutex;
+    QVector<Span> m_spans;
+};
+
+/**
+ * Traces the lifetime of the scope it is declared in
+ */
+class StartupTraceScope
+{
+public:
+    explicit StartupTraceScope(const QString &name, const QString &category = QString())
+        : m_span(StartupTracer::self().begin(name, category))
+    {
+    }
+    ~StartupTraceScope()
+    {
+        StartupTracer::self().end(m_span);
+    }
+
+    StartupTraceScope(const StartupTraceScope &) = delete;
+    StartupTraceScope &operator=(const StartupTraceScope &) = delete;
+
+private:
+    const int m_span;
+};
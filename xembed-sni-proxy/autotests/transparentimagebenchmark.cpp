@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <QtTest>
+
+#include "../transparentimage.h"
+
+Q_DECLARE_METATYPE(Simd::Kernel)
+
+class TransparentImageBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkPixelScan_data();
+    void benchmarkPixelScan();
+    void benchmarkHasAlpha_data();
+    void benchmarkHasAlpha();
+};
+
+// The scan as it was, column by column through QImage::pixel()
+static bool isTransparentImagePixelScan(const QImage &image)
+{
+    for (int x = 0; x < image.width(); ++x) {
+        for (int y = 0; y < image.height(); ++y) {
+            if (qAlpha(image.pixel(x, y))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Transparent images need a full scan. The usual icon sizes, and embedded windows
+// which are bigger than they should be, like KeePass2 or Chromium before resizing
+static const QSize s_captureSizes[] = {QSize(22, 22), QSize(32, 32), QSize(48, 48), QSize(64, 64), QSize(273, 273), QSize(1024, 768)};
+
+static QImage transparentImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+void TransparentImageBenchmark::benchmarkPixelScan_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    for (const QSize &size : s_captureSizes) {
+        QTest::addRow("%dx%d", size.width(), size.height()) << size;
+    }
+}
+
+void TransparentImageBenchmark::benchmarkPixelScan()
+{
+    QFETCH(QSize, size);
+    const QImage image = transparentImage(size);
+
+    QBENCHMARK {
+        QVERIFY(isTransparentImagePixelScan(image));
+    }
+}
+
+void TransparentImageBenchmark::benchmarkHasAlpha_data()
+{
+    QTest::addColumn<Simd::Kernel>("kernel");
+    QTest::addColumn<QSize>("size");
+
+    const QVector<Simd::Kernel> kernels = Simd::supportedKernels();
+    for (Simd::Kernel kernel : kernels) {
+        for (const QSize &size : s_captureSizes) {
+            QTest::addRow("%s-%dx%d", Simd::name(kernel), size.width(), size.height()) << kernel << size;
+        }
+    }
+}
+
+void TransparentImageBenchmark::benchmarkHasAlpha()
+{
+    QFETCH(Simd::Kernel, kernel);
+    QFETCH(QSize, size);
+    const QImage image = transparentImage(size);
+    const auto pixels = reinterpret_cast<const quint32 *>(image.constBits());
+
+    QBENCHMARK {
+        QVERIFY(!hasAlpha(pixels, size.width() * size.height(), kernel));
+    }
+}
+
+QTEST_GUILESS_MAIN(TransparentImageBenchmark)
+
+#include "transparentimagebenchmark.moc"
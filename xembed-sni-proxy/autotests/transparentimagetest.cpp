@@ -0,0 +1,135 @@
+/*
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include <QtTest>
+
+#include "../transparentimage.h"
+
+Q_DECLARE_METATYPE(Simd::Kernel)
+
+class TransparentImageTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testHasAlpha_data();
+    void testHasAlpha();
+    void testTransparent_data();
+    void testTransparent();
+    void testOpaquePixel_data();
+    void testOpaquePixel();
+    void testPaddedLines();
+    void testFormats();
+};
+
+void TransparentImageTest::testHasAlpha_data()
+{
+    QTest::addColumn<Simd::Kernel>("kernel");
+
+    const QVector<Simd::Kernel> kernels = Simd::supportedKernels();
+    for (Simd::Kernel kernel : kernels) {
+        QTest::newRow(Simd::name(kernel)) << kernel;
+    }
+}
+
+void TransparentImageTest::testHasAlpha()
+{
+    QFETCH(Simd::Kernel, kernel);
+
+    // Two unrolled AVX2 blocks and some, so every kernel goes through all its loops and the rest
+    for (int count = 0; count <= 70; ++count) {
+        QVector<quint32> pixels(count, 0x00ffffff);
+        QVERIFY2(!hasAlpha(pixels.constData(), count, kernel), qPrintable(QString::number(count)));
+        for (int i = 0; i < count; ++i) {
+            pixels[i] = 0x01000000;
+            QVERIFY2(hasAlpha(pixels.constData(), count, kernel), qPrintable(QStringLiteral("%1 at %2").arg(count).arg(i)));
+            pixels[i] = 0x00ffffff;
+        }
+    }
+}
+
+void TransparentImageTest::testTransparent_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("1x1") << QSize(1, 1);
+    QTest::newRow("22x22") << QSize(22, 22);
+    QTest::newRow("33x31") << QSize(33, 31);
+    QTest::newRow("oversized window") << QSize(273, 41);
+}
+
+void TransparentImageTest::testTransparent()
+{
+    QFETCH(QSize, size);
+
+    for (const QImage::Format format : {QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied}) {
+        QImage image(size, format);
+        // Colors without alpha still count as transparent
+        image.fill(0x00ffffff);
+        QVERIFY(isTransparentImage(image));
+    }
+}
+
+void TransparentImageTest::testOpaquePixel_data()
+{
+    testTransparent_data();
+}
+
+void TransparentImageTest::testOpaquePixel()
+{
+    QFETCH(QSize, size);
+
+    // Including the center pixels, which are looked at first
+    QImage image(size, QImage::Format_ARGB32);
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x) {
+            image.fill(Qt::transparent);
+            image.setPixel(x, y, qRgba(0, 0, 0, 1));
+            QVERIFY2(!isTransparentImage(image), qPrintable(QStringLiteral("%1,%2").arg(x).arg(y)));
+        }
+    }
+}
+
+void TransparentImageTest::testPaddedLines()
+{
+    // Like captured windows with a stride, only the pixels in the lines count
+    const int width = 5;
+    const int height = 4;
+    const int stride = 8 * 4;
+    QVector<quint32> data(8 * height, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = width; x < 8; ++x) {
+            data[y * 8 + x] = 0xff000000;
+        }
+    }
+
+    QImage image(reinterpret_cast<uchar *>(data.data()), width, height, stride, QImage::Format_ARGB32);
+    QVERIFY(isTransparentImage(image));
+
+    data[3 * 8 + 4] = 0x01000000;
+    QVERIFY(!isTransparentImage(image));
+}
+
+void TransparentImageTest::testFormats()
+{
+    QVERIFY(isTransparentImage(QImage()));
+
+    QImage rgb(16, 16, QImage::Format_RGB32);
+    rgb.fill(Qt::black);
+    QVERIFY(!isTransparentImage(rgb));
+
+    QImage indexed(16, 16, QImage::Format_Indexed8);
+    indexed.setColorCount(2);
+    indexed.setColor(0, qRgba(0, 0, 0, 0));
+    indexed.setColor(1, qRgba(0, 0, 0, 0xff));
+    indexed.fill(0);
+    QVERIFY(isTransparentImage(indexed));
+    indexed.setPixel(15, 15, 1);
+    QVERIFY(!isTransparentImage(indexed));
+}
+
+QTEST_GUILESS_MAIN(TransparentImageTest)
+
+#include "transparentimagetest.moc"
@@ -80,7 +80,8 @@ bool FdoSelectionManager::addDamageWatch(xcb_window_t client)
 
     const auto damageId = xcb_generate_id(c);
     m_damageWatches[client] = damageId;
-    xcb_damage_create(c, damageId, client, XCB_DAMAGE_REPORT_LEVEL_NON_EMPTY);
+    // every newly damaged rectangle is reported, the proxy repairs the damage when it captures the icon
+    xcb_damage_create(c, damageId, client, XCB_DAMAGE_REPORT_LEVEL_DELTA_RECTANGLES);
 
     xcb_generic_error_t *error = nullptr;
     UniqueCPointer<xcb_get_window_attributes_reply_t> attr(xcb_get_window_attributes_reply(c, attribsCookie, &error));
@@ -140,11 +141,10 @@ bool FdoSelectionManager::nativeEventFilter(const QByteArray &eventType, void *m
             undock(destroyedWId);
         }
     } else if (responseType == m_damageEventBase + XCB_DAMAGE_NOTIFY) {
-        const auto damagedWId = reinterpret_cast<xcb_damage_notify_event_t *>(ev)->drawable;
-        const auto sniProxy = m_proxies.value(damagedWId);
+        const auto event = reinterpret_cast<xcb_damage_notify_event_t *>(ev);
+        const auto sniProxy = m_proxies.value(event->drawable);
         if (sniProxy) {
-            sniProxy->update();
-            xcb_damage_subtract(QX11Info::connection(), m_damageWatches[damagedWId], XCB_NONE, XCB_NONE);
+            sniProxy->addDamage(QRect(event->area.x, event->area.y, event->area.width, event->area.height));
         }
     } else if (responseType == XCB_CONFIGURE_REQUEST) {
         const auto event = reinterpret_cast<xcb_configure_request_event_t *>(ev);
@@ -178,7 +178,7 @@ void FdoSelectionManager::dock(xcb_window_t winId)
     }
 
     if (addDamageWatch(winId)) {
-        m_proxies[winId] = new SNIProxy(winId, this);
+        m_proxies[winId] = new SNIProxy(winId, m_damageWatches[winId], this);
     }
 }
 
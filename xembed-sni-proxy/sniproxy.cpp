@@ -16,6 +16,7 @@
 #include "xcbutils.h"
 
 #include <QGuiApplication>
+#include <QHash>
 #include <QScreen>
 #include <QTimer>
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -26,6 +27,8 @@
 
 #include <QBitmap>
 
+#include <KConfigGroup>
+#include <KSharedConfig>
 #include <KWindowSystem>
 #include <netwm.h>
 
@@ -33,6 +36,7 @@
 #include "statusnotifierwatcher_interface.h"
 
 #include "../c_ptr.h"
+#include "transparentimage.h"
 #include "xtestsender.h"
 
 //#define VISUAL_DEBUG
@@ -42,9 +46,28 @@
 
 static uint16_t s_embedSize = 32; // max size of window to embed. We no longer resize the embedded window as Chromium acts stupidly.
 static unsigned int XEMBED_VERSION = 0;
+static const int s_frameInterval = 16; // damage within this time is captured at once
+static const int s_defaultCaptureRate = 10; // max captures per second and icon, unless configured otherwise
 
 int SNIProxy::s_serviceCount = 0;
 
+// The minimum time between two captures of the icon, configured in xembedsniproxyrc:
+// MaxCaptureRate in [General] for all icons, or the window class as key in [CaptureRates]
+static int captureInterval(xcb_window_t wid)
+{
+    KSharedConfig::Ptr config = KSharedConfig::openConfig(QStringLiteral("xembedsniproxyrc"), KConfig::NoGlobals);
+
+    int rate = config->group(QStringLiteral("General")).readEntry("MaxCaptureRate", s_defaultCaptureRate);
+
+    KWindowInfo window(wid, NET::Properties(), NET::WM2WindowClass);
+    const QString windowClass = QString::fromLocal8Bit(window.windowClassClass());
+    if (!windowClass.isEmpty()) {
+        rate = config->group(QStringLiteral("CaptureRates")).readEntry(windowClass, rate);
+    }
+
+    return rate > 0 ? 1000 / rate : 0;
+}
+
 void xembed_message_send(xcb_window_t towin, long message, long d1, long d2, long d3)
 {
     xcb_client_message_event_t ev;
@@ -61,7 +84,7 @@ void xembed_message_send(xcb_window_t towin, long message, long d1, long d2, lon
     xcb_send_event(QX11Info::connection(), false, towin, XCB_EVENT_MASK_NO_EVENT, (char *)&ev);
 }
 
-SNIProxy::SNIProxy(xcb_window_t wid, QObject *parent)
+SNIProxy::SNIProxy(xcb_window_t wid, xcb_damage_damage_t damageId, QObject *parent)
     : QObject(parent)
     ,
     // Work round a bug in our SNIWatcher with multiple SNIs per connection.
@@ -69,9 +92,14 @@ SNIProxy::SNIProxy(xcb_window_t wid, QObject *parent)
     // service closing instead lets use one DBus connection per SNI
     m_dbus(QDBusConnection::connectToBus(QDBusConnection::SessionBus, QStringLiteral("XembedSniProxy%1").arg(s_serviceCount++)))
     , m_windowId(wid)
+    , m_damageId(damageId)
+    , m_captureInterval(captureInterval(wid))
     , sendingClickEvent(false)
     , m_injectMode(Direct)
 {
+    m_captureTimer.setSingleShot(true);
+    connect(&m_captureTimer, &QTimer::timeout, this, &SNIProxy::update);
+
     // create new SNI
     new StatusNotifierItemAdaptor(this);
     m_dbus.registerObject(QStringLiteral("/StatusNotifierItem"), this);
@@ -189,24 +217,78 @@ SNIProxy::~SNIProxy()
     QDBusConnection::disconnectFromBus(m_dbus.name());
 }
 
+void SNIProxy::addDamage(const QRect &rect)
+{
+    m_damage |= rect;
+
+    if (m_captureTimer.isActive()) {
+        return;
+    }
+    qint64 delay = s_frameInterval;
+    if (m_lastCapture.isValid()) {
+        delay = std::max(delay, m_captureInterval - m_lastCapture.elapsed());
+    }
+    m_captureTimer.start(static_cast<int>(delay));
+}
+
 void SNIProxy::update()
 {
-    const QImage image = getImageNonComposite();
-    if (image.isNull()) {
-        qCDebug(SNIPROXY) << "No xembed icon for" << m_windowId << Title();
+    m_captureTimer.stop();
+    m_lastCapture.start();
+
+    // Repair before capturing, whatever is drawn from now on gets reported again
+    xcb_damage_subtract(QX11Info::connection(), m_damageId, XCB_NONE, XCB_NONE);
+
+    const QRect damage = m_damage;
+    m_damage = QRect();
+
+    if (m_image.isNull() || !m_imageIsArgb || damage.isEmpty() || damage.contains(m_image.rect()) || !updateImage(damage)) {
+        m_image = getImageNonComposite(&m_imageIsArgb);
+        if (m_image.isNull()) {
+            qCDebug(SNIPROXY) << "No xembed icon for" << m_windowId << Title();
+            return;
+        }
+    }
+
+    const size_t hash = qHashBits(m_image.constBits(), m_image.sizeInBytes(), m_image.width());
+    if (hash == m_imageHash && !m_pixmap.isNull()) {
         return;
     }
+    m_imageHash = hash;
 
-    int w = image.width();
-    int h = image.height();
+    int w = m_image.width();
+    int h = m_image.height();
 
-    m_pixmap = QPixmap::fromImage(image);
+    m_pixmap = QPixmap::fromImage(m_image);
     if (w > s_embedSize || h > s_embedSize) {
         qCDebug(SNIPROXY) << "Scaling pixmap of window" << m_windowId << Title() << "from w*h" << w << h;
         m_pixmap = m_pixmap.scaled(s_embedSize, s_embedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     }
     Q_EMIT NewIcon();
-    Q_EMIT NewToolTip();
+}
+
+bool SNIProxy::updateImage(const QRect &rect)
+{
+    const QRect area = rect & m_image.rect();
+    if (area.isEmpty()) {
+        return true;
+    }
+
+    auto c = QX11Info::connection();
+    xcb_image_t *image = xcb_image_get(c, m_windowId, area.x(), area.y(), area.width(), area.height(), 0xFFFFFFFF, XCB_IMAGE_FORMAT_Z_PIXMAP);
+    if (!image) {
+        return false;
+    }
+
+    // Both are ARGB32, copy the damaged rows over into the last capture
+    const int bytes = std::min<int>(area.width() * 4, image->stride);
+    for (int y = 0; y < std::min<int>(area.height(), image->height); ++y) {
+        memcpy(m_image.scanLine(area.y() + y) + area.x() * 4, image->data + y * image->stride, bytes);
+    }
+    xcb_image_destroy(image);
+
+    // Let a full capture deal with an icon gone transparent
+    return !isTransparentImage(m_image);
 }
 
 void SNIProxy::resizeWindow(const uint16_t width, const uint16_t height) const
@@ -261,31 +343,12 @@ void sni_cleanup_xcb_image(void *data)
     xcb_image_destroy(static_cast<xcb_image_t *>(data));
 }
 
-bool SNIProxy::isTransparentImage(const QImage &image) const
+QImage SNIProxy::getImageNonComposite(bool *argb) const
 {
-    int w = image.width();
-    int h = image.height();
-
-    // check for the center and sub-center pixels first and avoid full image scan
-    if (!(qAlpha(image.pixel(w >> 1, h >> 1)) + qAlpha(image.pixel(w >> 2, h >> 2)) == 0))
-        return false;
-
-    // skip scan altogether if sub-center pixel found to be opaque
-    // and break out from the outer loop too on full scan
-    for (int x = 0; x < w; ++x) {
-        for (int y = 0; y < h; ++y) {
-            if (qAlpha(image.pixel(x, y))) {
-                // Found an opaque pixel.
-                return false;
-            }
-        }
+    if (argb) {
+        *argb = false;
     }
 
-    return true;
-}
-
-QImage SNIProxy::getImageNonComposite() const
-{
     auto c = QX11Info::connection();
 
     QSize clientWindowSize = calculateClientWindowSize();
@@ -314,6 +377,9 @@ QImage SNIProxy::getImageNonComposite() const
         } else
             return elaborateConversion;
     } else {
+        if (argb) {
+            *argb = true;
+        }
         // Now we are sure we can eventually delete the xcb_image_t with this version
         return QImage(image->data, image->width, image->height, image->stride, QImage::Format_ARGB32, sni_cleanup_xcb_image, image);
     }
@@ -11,10 +11,15 @@
 #include <QDBusArgument>
 #include <QDBusConnection>
 #include <QDBusObjectPath>
+#include <QElapsedTimer>
+#include <QImage>
 #include <QObject>
 #include <QPixmap>
 #include <QPoint>
+#include <QRect>
+#include <QTimer>
 
+#include <xcb/damage.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_image.h>
 
@@ -32,10 +37,17 @@ class SNIProxy : public QObject
     Q_PROPERTY(KDbusImageVector IconPixmap READ IconPixmap)
 
 public:
-    explicit SNIProxy(xcb_window_t wid, QObject *parent = nullptr);
+    explicit SNIProxy(xcb_window_t wid, xcb_damage_damage_t damageId, QObject *parent = nullptr);
     ~SNIProxy() override;
 
+    /**
+     * Captures the damaged part of the embedded window, or all of it, right away
+     */
     void update();
+    /**
+     * Schedules a capture of @p rect, coalesced with the rest of the frame and limited to the capture rate
+     */
+    void addDamage(const QRect &rect);
     void resizeWindow(const uint16_t width, const uint16_t height) const;
     void hideContainerWindow(xcb_window_t windowId) const;
 
@@ -137,8 +149,9 @@ private:
 
     QSize calculateClientWindowSize() const;
     void sendClick(uint8_t mouseButton, int x, int y);
-    QImage getImageNonComposite() const;
-    bool isTransparentImage(const QImage &image) const;
+    // @p argb is set when the window contents are plain ARGB32, which can be patched in place
+    QImage getImageNonComposite(bool *argb = nullptr) const;
+    bool updateImage(const QRect &rect);
     QImage convertFromNative(xcb_image_t *xcbImage) const;
     QPoint calculateClickPoint() const;
     void stackContainerWindow(const uint32_t stackMode) const;
@@ -146,8 +159,17 @@ private:
     QDBusConnection m_dbus;
     xcb_window_t m_windowId;
     xcb_window_t m_containerWid;
+    xcb_damage_damage_t m_damageId;
     static int s_serviceCount;
     QPixmap m_pixmap;
+    // The last capture, before scaling, and the hash of its pixels
+    QImage m_image;
+    bool m_imageIsArgb = false;
+    size_t m_imageHash = 0;
+    QRect m_damage;
+    QTimer m_captureTimer;
+    QElapsedTimer m_lastCapture;
+    int m_captureInterval;
     bool sendingClickEvent;
     InjectMode m_injectMode;
 };
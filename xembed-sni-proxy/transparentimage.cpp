@@ -0,0 +1,155 @@
+/* Alpha scan of captured icons, kept apart from SNIProxy so it can be tested and benchmarked
+
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#include "transparentimage.h"
+
+static const quint32 s_alphaMask = 0xff000000;
+
+static bool hasAlphaScalar(const quint32 *pixels, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        if (pixels[i] & s_alphaMask) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(SIMD_SSE2)
+static bool hasAlphaSse2(const quint32 *pixels, int count)
+{
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(s_alphaMask));
+    const __m128i zero = _mm_setzero_si128();
+
+    int i = 0;
+    // Four vectors at a time, a single test for all of them
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 4));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 8));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i + 12));
+        const __m128i alpha = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) != 0xffff) {
+            return true;
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        const __m128i alpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i)), alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) != 0xffff) {
+            return true;
+        }
+    }
+    return hasAlphaScalar(pixels + i, count - i);
+}
+#endif
+
+#if defined(SIMD_AVX2)
+// vptest checks the alpha bytes of all eight pixels at once
+SIMD_TARGET_AVX2 static bool hasAlphaAvx2(const quint32 *pixels, int count)
+{
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(s_alphaMask));
+
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i + 8));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i + 16));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i + 24));
+        if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), alphaMask)) {
+            return true;
+        }
+    }
+    for (; i + 8 <= count; i += 8) {
+        if (!_mm256_testz_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i)), alphaMask)) {
+            return true;
+        }
+    }
+    return hasAlphaScalar(pixels + i, count - i);
+}
+#endif
+
+#if defined(SIMD_NEON)
+static bool hasAlphaNeon(const quint32 *pixels, int count)
+{
+    const uint32x4_t alphaMask = vdupq_n_u32(s_alphaMask);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const uint32x4_t a = vld1q_u32(pixels + i);
+        const uint32x4_t b = vld1q_u32(pixels + i + 4);
+        const uint32x4_t c = vld1q_u32(pixels + i + 8);
+        const uint32x4_t d = vld1q_u32(pixels + i + 12);
+        const uint32x4_t alpha = vandq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d)), alphaMask);
+        const uint32x2_t folded = vorr_u32(vget_low_u32(alpha), vget_high_u32(alpha));
+        if (vget_lane_u64(vreinterpret_u64_u32(folded), 0) != 0) {
+            return true;
+        }
+    }
+    return hasAlphaScalar(pixels + i, count - i);
+}
+#endif
+
+bool hasAlpha(const quint32 *pixels, int count, Simd::Kernel kernel)
+{
+    Q_ASSERT(Simd::isSupported(kernel));
+    switch (kernel) {
+#if defined(SIMD_SSE2)
+    case Simd::Kernel::Sse2:
+        return hasAlphaSse2(pixels, count);
+#endif
+#if defined(SIMD_AVX2)
+    case Simd::Kernel::Avx2:
+        return hasAlphaAvx2(pixels, count);
+#endif
+#if defined(SIMD_NEON)
+    case Simd::Kernel::Neon:
+        return hasAlphaNeon(pixels, count);
+#endif
+    default:
+        return hasAlphaScalar(pixels, count);
+    }
+}
+
+bool isTransparentImage(const QImage &image)
+{
+    const int w = image.width();
+    const int h = image.height();
+
+    if (image.format() != QImage::Format_ARGB32 && image.format() != QImage::Format_ARGB32_Premultiplied) {
+        if (!image.hasAlphaChannel()) {
+            return image.isNull();
+        }
+        // Rare formats, row by row still
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                if (qAlpha(image.pixel(x, y))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // check for the center and sub-center pixels first and avoid full image scan
+    const auto pixelAt = [&image](int x, int y) {
+        return reinterpret_cast<const quint32 *>(image.constScanLine(y))[x];
+    };
+    if ((pixelAt(w >> 1, h >> 1) | pixelAt(w >> 2, h >> 2)) & s_alphaMask) {
+        return false;
+    }
+
+    // Captured windows are not padded, scan them at once
+    if (image.bytesPerLine() == w * 4) {
+        return !hasAlpha(reinterpret_cast<const quint32 *>(image.constBits()), w * h);
+    }
+    for (int y = 0; y < h; ++y) {
+        if (hasAlpha(reinterpret_cast<const quint32 *>(image.constScanLine(y)), w)) {
+            return false;
+        }
+    }
+    return true;
+}
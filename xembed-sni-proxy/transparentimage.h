@@ -0,0 +1,21 @@
+/* Alpha scan of captured icons, kept apart from SNIProxy so it can be tested and benchmarked
+
+    SPDX-FileCopyrightText: 2026 Plasma Workspace contributors
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+#pragma once
+
+#include <QImage>
+
+#include "../simd_dispatch.h"
+
+/**
+ * @return whether every pixel of @p image is fully transparent
+ */
+bool isTransparentImage(const QImage &image);
+
+/**
+ * @return whether any of the @p count 32 bit pixels at @p pixels has some alpha
+ */
+bool hasAlpha(const quint32 *pixels, int count, Simd::Kernel kernel = Simd::best());